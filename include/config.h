@@ -19,27 +19,21 @@
 #define SDA_PIN D2 // GPIO4
 #define SCL_PIN D1 // GPIO5
 
-constexpr const char wifi_scan[] = "SKAN SIECI WIFI";
-constexpr const char deauth[] = "DEAUTORYZACJA";
-constexpr const char evil_twin[] = "EVIL TWIN";
-constexpr const char beacon_spam[] = "BEACON_SPAM";
-constexpr const char sniffing[] = "SNIFFING";
-constexpr const char settings[] = "USTAWIENIA";
-constexpr const char info[] = "INFO";
-
-constexpr const char wifi_scan_id = 0;
-constexpr const char deauth_id = 1;
-constexpr const char evil_twin_id = 2;
-constexpr const char beacon_spam_id = 3;
-constexpr const char sniffing_id = 4;
-constexpr const char settings_id = 5;
-constexpr const char info_id = 6;
-
-constexpr const char *menuItems[] = {
-    wifi_scan, deauth, evil_twin, beacon_spam, sniffing, settings, info,
-};
-
-constexpr int MENU_SIZE = sizeof(menuItems) / sizeof(menuItems[0]);
+// Debug build: skips the startup animation and compiles in the profiler
+// (src/debug/profile.h). Set with -DKVDAN_DEBUG=1, see env:nodemcuv2-debug
+#ifndef KVDAN_DEBUG
+#define KVDAN_DEBUG 0
+#endif
+
+constexpr bool debug = KVDAN_DEBUG;
+
+// Benchmark build: setup() first runs the UI benchmarks in src/bench and
+// prints the results over Serial. Set with -DKVDAN_BENCH=1
+#ifndef KVDAN_BENCH
+#define KVDAN_BENCH 0
+#endif
+
+constexpr bool bench = KVDAN_BENCH;
 
 const uint8_t heartBitmap[] PROGMEM = {0b01100111, 0b10000000, 0b10000000,
                                        0b11111111, 0b01111110, 0b00111100,
@@ -0,0 +1,325 @@
+"""Pre-renders the startup animation into PROGMEM sprite sheets.
+
+The hamster and sparkle-burst frames used to be drawn at boot from dozens
+of fillCircle/drawLine calls per frame. This script rasterizes them once,
+with the same algorithms Adafruit GFX uses, into 1-bpp page-packed data
+(the SH1106 buffer layout) and RLE-compresses each frame. ui.cpp plays
+them back with drawSprite().
+
+Runs as a PlatformIO pre-script (the header lands in the build dir), or
+standalone: python3 scripts/gen_sprites.py <output dir>
+"""
+
+import math
+import os
+import re
+import sys
+
+WIDTH = 128
+HEIGHT = 64
+CENTER_X = WIDTH // 2
+CENTER_Y = HEIGHT // 2
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+HEADER = "startup_sprites.h"
+
+
+# ===== RASTERIZER (same algorithms as Adafruit GFX) =====
+
+
+class Canvas:
+    def __init__(self):
+        self.px = [[0] * WIDTH for _ in range(HEIGHT)]
+
+    def pixel(self, x, y, color=1):
+        if 0 <= x < WIDTH and 0 <= y < HEIGHT:
+            self.px[y][x] = color
+
+    def vline(self, x, y, h, color=1):
+        for i in range(h):
+            self.pixel(x, y + i, color)
+
+    def line(self, x0, y0, x1, y1, color=1):
+        steep = abs(y1 - y0) > abs(x1 - x0)
+        if steep:
+            x0, y0, x1, y1 = y0, x0, y1, x1
+        if x0 > x1:
+            x0, x1, y0, y1 = x1, x0, y1, y0
+        dx = x1 - x0
+        dy = abs(y1 - y0)
+        err = dx // 2
+        ystep = 1 if y0 < y1 else -1
+        while x0 <= x1:
+            if steep:
+                self.pixel(y0, x0, color)
+            else:
+                self.pixel(x0, y0, color)
+            err -= dy
+            if err < 0:
+                y0 += ystep
+                err += dx
+            x0 += 1
+
+    def fill_circle(self, x0, y0, r, color=1):
+        self.vline(x0, y0 - r, 2 * r + 1, color)
+        f = 1 - r
+        ddf_x = 1
+        ddf_y = -2 * r
+        x = 0
+        y = r
+        px = x
+        py = y
+        delta = 1
+        while x < y:
+            if f >= 0:
+                y -= 1
+                ddf_y += 2
+                f += ddf_y
+            x += 1
+            ddf_x += 2
+            f += ddf_x
+            if x < y + 1:
+                self.vline(x0 + x, y0 - y, 2 * y + delta, color)
+                self.vline(x0 - x, y0 - y, 2 * y + delta, color)
+            if y != py:
+                self.vline(x0 + py, y0 - px, 2 * px + delta, color)
+                self.vline(x0 - py, y0 - px, 2 * px + delta, color)
+                py = y
+            px = x
+
+    def bitmap(self, x, y, rows, w, color=1):
+        byte_width = (w + 7) // 8
+        for j in range(len(rows) // byte_width):
+            for i in range(w):
+                byte = rows[j * byte_width + i // 8]
+                if byte & (0x80 >> (i & 7)):
+                    self.pixel(x + i, y + j, color)
+
+    def pages(self, x, width, page, pages):
+        """Page-packed bytes of a rect, page by page, LSB = top row."""
+        out = []
+        for p in range(page, page + pages):
+            for col in range(x, x + width):
+                byte = 0
+                for bit in range(8):
+                    if self.px[p * 8 + bit][col]:
+                        byte |= 1 << bit
+                out.append(byte)
+        return out
+
+
+# ===== FIXED-POINT TRIG (matches src/ui/fixmath.cpp) =====
+
+FIX_SHIFT = 14
+FIX_ONE = 1 << FIX_SHIFT
+SINE = [int(math.sin(math.radians(d)) * FIX_ONE + 0.5) for d in range(91)]
+
+
+def fix_sin(deg):
+    deg %= 360
+    negative = deg >= 180
+    if negative:
+        deg -= 180
+    if deg > 90:
+        deg = 180 - deg
+    return -SINE[deg] if negative else SINE[deg]
+
+
+def fix_mul(value, q):
+    return (value * q + (1 << (FIX_SHIFT - 1))) >> FIX_SHIFT
+
+
+def fix_polar(cx, cy, deg, radius):
+    return (cx + fix_mul(radius, fix_sin(deg + 90)),
+            cy + fix_mul(radius, fix_sin(deg)))
+
+
+def fix_bounce(deg, height):
+    return fix_mul(height, abs(fix_sin(deg)))
+
+
+# ===== FRAMES =====
+
+
+def heart_bitmap():
+    with open(os.path.join(ROOT, "include", "config.h")) as f:
+        source = f.read()
+    body = re.search(r"heartBitmap\[\]\s*PROGMEM\s*=\s*\{([^}]*)\}", source)
+    return [int(v, 0) for v in body.group(1).replace("\n", " ").split(",")
+            if v.strip()]
+
+
+# The "zzz" of the sleeping frames is font text and stays runtime-drawn
+def hamster_frame(frame, heart):
+    c = Canvas()
+    cx, cy = CENTER_X, CENTER_Y
+
+    if frame < 6:
+        # hamster sleeping - curled up ball
+        breathe = fix_bounce(frame * 69, 2)
+        c.fill_circle(cx, cy + breathe, 10)
+        c.fill_circle(cx - 3, cy - 3 + breathe, 6)
+        # closed eyes
+        c.line(cx - 2, cy - 2 + breathe, cx - 4, cy - 2 + breathe, 0)
+        c.line(cx + 2, cy - 2 + breathe, cx + 4, cy - 2 + breathe, 0)
+
+    elif frame < 12:
+        # waking up - stretching
+        stretch = frame - 6
+        c.fill_circle(cx, cy, 9)
+        c.fill_circle(cx - 4, cy - 4, 5)
+        if stretch > 2:  # ears pop up
+            c.fill_circle(cx - 7, cy - 10, 3)
+            c.fill_circle(cx - 1, cy - 11, 3)
+        if stretch > 1:  # eyes opening
+            c.pixel(cx - 3, cy - 3, 0)
+            c.pixel(cx + 1, cy - 3, 0)
+        if stretch > 4:  # little paws stretching out
+            c.fill_circle(cx - 12, cy + 3, 2)
+            c.fill_circle(cx + 8, cy + 3, 2)
+
+    else:
+        # fully awake and happy
+        phase = frame - 12
+        w = 1 if phase % 2 == 0 else -1
+        c.fill_circle(cx + w, cy, 9)
+        c.fill_circle(cx - 4 + w, cy - 4, 5)
+        # ears
+        c.fill_circle(cx - 7 + w, cy - 10, 3)
+        c.fill_circle(cx - 1 + w, cy - 11, 3)
+        # happy eyes (^_^)
+        c.line(cx - 4 + w, cy - 3, cx - 2 + w, cy - 3, 0)
+        c.line(cx + w, cy - 3, cx + 2 + w, cy - 3, 0)
+        # nose
+        c.pixel(cx - 1 + w, cy - 1, 0)
+        # paws
+        c.fill_circle(cx - 10 + w, cy + 5, 2)
+        c.fill_circle(cx + 6 + w, cy + 5, 2)
+        # cheeks
+        c.fill_circle(cx - 8 + w, cy, 3)
+        c.fill_circle(cx + 4 + w, cy, 3)
+        if phase > 4:  # hearts
+            c.bitmap(cx - 25, cy - 8, heart, 8)
+            c.bitmap(cx + 15, cy - 8, heart, 8)
+        if phase > 6:  # sparkles
+            c.pixel(cx - 20, cy - 15)
+            c.pixel(cx + 18, cy - 15)
+            c.pixel(cx, cy - 20)
+    return c
+
+
+def burst_frame(burst):
+    c = Canvas()
+    for i in range(12):
+        x, y = fix_polar(CENTER_X, CENTER_Y, i * 30, burst * 8)
+        if 0 <= x < WIDTH and 0 <= y < HEIGHT:
+            c.fill_circle(x, y, 1)
+    return c
+
+
+# ===== ENCODING =====
+
+
+def bounding_pages(canvases):
+    """Smallest page-aligned rect holding every lit pixel of every frame."""
+    xs, ys = [], []
+    for c in canvases:
+        for y in range(HEIGHT):
+            for x in range(WIDTH):
+                if c.px[y][x]:
+                    xs.append(x)
+                    ys.append(y)
+    x0, x1 = min(xs), max(xs)
+    page0, page1 = min(ys) // 8, max(ys) // 8
+    return x0, x1 - x0 + 1, page0, page1 - page0 + 1
+
+
+def rle(data):
+    """PackBits: n < 128 -> n + 1 literal bytes, n >= 128 -> next byte
+    repeated n - 125 times (3..130)."""
+    out = []
+    literal = []
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and data[i + run] == data[i] and run < 130:
+            run += 1
+        if run >= 3:
+            if literal:
+                out += [len(literal) - 1] + literal
+                literal = []
+            out += [run + 125, data[i]]
+            i += run
+        else:
+            literal.append(data[i])
+            if len(literal) == 128:
+                out += [127] + literal
+                literal = []
+            i += 1
+    if literal:
+        out += [len(literal) - 1] + literal
+    return out
+
+
+def sheet(name, canvases):
+    x, width, page, pages = bounding_pages(canvases)
+    data, offsets = [], []
+    for c in canvases:
+        offsets.append(len(data))
+        data += rle(c.pages(x, width, page, pages))
+    raw = width * pages * len(canvases)
+
+    lines = ["// %d frames, %dx%d px at (%d, page %d), %d -> %d bytes"
+             % (len(canvases), width, pages * 8, x, page, raw, len(data))]
+    lines.append("static const uint8_t %sData[] PROGMEM = {" % name)
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16])
+                     + ",")
+    lines.append("};")
+    lines.append("static const uint16_t %sOffsets[] PROGMEM = {" % name)
+    for i in range(0, len(offsets), 8):
+        lines.append("    " + ", ".join(str(o) for o in offsets[i:i + 8])
+                     + ",")
+    lines.append("};")
+    lines.append("static constexpr SpriteSheet %sSheet = {%d, %d, %d, %d, %d, "
+                 "%sOffsets, %sData};" % (name, x, width, page, pages,
+                                           len(canvases), name, name))
+    return "\n".join(lines)
+
+
+def generate(out_dir):
+    heart = heart_bitmap()
+    text = "\n".join([
+        "// generated by scripts/gen_sprites.py - do not edit",
+        "#ifndef STARTUP_SPRITES_H",
+        "#define STARTUP_SPRITES_H",
+        "",
+        "#include \"ui/sprite.h\"",
+        "",
+        sheet("hamster", [hamster_frame(f, heart) for f in range(22)]),
+        "",
+        sheet("burst", [burst_frame(b) for b in range(8)]),
+        "",
+        "#endif",
+        "",
+    ])
+
+    os.makedirs(out_dir, exist_ok=True)
+    path = os.path.join(out_dir, HEADER)
+    # untouched header, no rebuild of ui.cpp
+    if os.path.exists(path):
+        with open(path) as f:
+            if f.read() == text:
+                return
+    with open(path, "w") as f:
+        f.write(text)
+
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO
+    out = os.path.join(env.subst("$BUILD_DIR"), "generated")  # noqa: F821
+    generate(out)
+    env.Append(CPPPATH=[out])  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        generate(sys.argv[1] if len(sys.argv) > 1 else ".")
@@ -0,0 +1,105 @@
+#ifndef _ADAFRUIT_GFX_H
+#define _ADAFRUIT_GFX_H
+
+// Host copy of the Adafruit_GFX interface used by the firmware. The drawing
+// algorithms in sim/src/gfx.cpp follow the library so snapshots match what
+// the panel shows pixel for pixel.
+
+#include "Arduino.h"
+#include "gfxfont.h"
+
+class Adafruit_GFX : public Print {
+  public:
+    Adafruit_GFX(int16_t w, int16_t h);
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+
+    virtual void startWrite() {}
+    virtual void writePixel(int16_t x, int16_t y, uint16_t color) {
+        drawPixel(x, y, color);
+    }
+    virtual void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                               uint16_t color) {
+        fillRect(x, y, w, h, color);
+    }
+    virtual void writeFastVLine(int16_t x, int16_t y, int16_t h,
+                                uint16_t color) {
+        drawFastVLine(x, y, h, color);
+    }
+    virtual void writeFastHLine(int16_t x, int16_t y, int16_t w,
+                                uint16_t color) {
+        drawFastHLine(x, y, w, color);
+    }
+    virtual void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                           uint16_t color);
+    virtual void endWrite() {}
+
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h,
+                               uint16_t color);
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w,
+                               uint16_t color);
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                          uint16_t color);
+    virtual void fillScreen(uint16_t color);
+    virtual void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                          uint16_t color);
+    virtual void drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                          uint16_t color);
+
+    void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+    void drawCircleHelper(int16_t x0, int16_t y0, int16_t r,
+                          uint8_t cornername, uint16_t color);
+    void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+    void fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners,
+                          int16_t delta, uint16_t color);
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                    int16_t h, uint16_t color);
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+                  uint16_t bg, uint8_t size);
+
+    void getTextBounds(const char *string, int16_t x, int16_t y, int16_t *x1,
+                       int16_t *y1, uint16_t *w, uint16_t *h);
+    void getTextBounds(const __FlashStringHelper *s, int16_t x, int16_t y,
+                       int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h);
+    void getTextBounds(const String &str, int16_t x, int16_t y, int16_t *x1,
+                       int16_t *y1, uint16_t *w, uint16_t *h);
+
+    void setTextSize(uint8_t s) { textsize_x = textsize_y = s > 0 ? s : 1; }
+    void setFont(const GFXfont *f = NULL) { gfxFont = (GFXfont *)f; }
+    void setCursor(int16_t x, int16_t y) {
+        cursor_x = x;
+        cursor_y = y;
+    }
+    void setTextColor(uint16_t c) { textcolor = textbgcolor = c; }
+    void setTextColor(uint16_t c, uint16_t bg) {
+        textcolor = c;
+        textbgcolor = bg;
+    }
+    void setTextWrap(bool w) { wrap = w; }
+    void cp437(bool x = true) { _cp437 = x; }
+
+    using Print::write;
+    virtual size_t write(uint8_t c) override;
+
+    int16_t width(void) const { return _width; }
+    int16_t height(void) const { return _height; }
+    uint8_t getRotation(void) const { return rotation; }
+    int16_t getCursorX(void) const { return cursor_x; }
+    int16_t getCursorY(void) const { return cursor_y; }
+
+  protected:
+    void charBounds(unsigned char c, int16_t *x, int16_t *y, int16_t *minx,
+                    int16_t *miny, int16_t *maxx, int16_t *maxy);
+
+    int16_t WIDTH, HEIGHT;
+    int16_t _width, _height;
+    int16_t cursor_x, cursor_y;
+    uint16_t textcolor, textbgcolor;
+    uint8_t textsize_x, textsize_y;
+    uint8_t rotation;
+    bool wrap;
+    bool _cp437;
+    GFXfont *gfxFont;
+};
+
+#endif
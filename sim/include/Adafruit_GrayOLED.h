@@ -0,0 +1,45 @@
+#ifndef _Adafruit_GRAYOLED_H_
+#define _Adafruit_GRAYOLED_H_
+
+#include <Adafruit_GFX.h>
+#include <Adafruit_I2CDevice.h>
+
+#define GRAYOLED_SETCONTRAST 0x81
+#define GRAYOLED_NORMALDISPLAY 0xA6
+#define GRAYOLED_INVERTDISPLAY 0xA7
+
+#define MONOOLED_BLACK 0
+#define MONOOLED_WHITE 1
+#define MONOOLED_INVERSE 2
+
+class Adafruit_GrayOLED : public Adafruit_GFX {
+  public:
+    Adafruit_GrayOLED(uint8_t bpp, uint16_t w, uint16_t h,
+                      TwoWire *twi = &Wire, int8_t rst_pin = -1,
+                      uint32_t preclk = 400000, uint32_t postclk = 100000);
+    ~Adafruit_GrayOLED(void);
+
+    virtual void display(void) = 0;
+    void clearDisplay(void);
+    void invertDisplay(bool i);
+    void setContrast(uint8_t contrastlevel);
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    bool getPixel(int16_t x, int16_t y);
+    uint8_t *getBuffer(void) { return buffer; }
+
+    void oled_command(uint8_t c);
+    bool oled_commandList(const uint8_t *c, uint8_t n);
+
+  protected:
+    bool _init(uint8_t i2caddr = 0x3C, bool reset = true);
+
+    Adafruit_I2CDevice *i2c_dev = NULL;
+    TwoWire *_theWire = NULL;
+    int16_t window_x1, window_y1, window_x2, window_y2;
+    int rstPin;
+    uint8_t *buffer = NULL;
+    uint8_t _bpp = 1;
+    uint32_t i2c_preclk = 400000, i2c_postclk = 100000;
+};
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef Adafruit_I2CDevice_h
+#define Adafruit_I2CDevice_h
+
+#include <Arduino.h>
+#include <Wire.h>
+
+class Adafruit_I2CDevice {
+  public:
+    Adafruit_I2CDevice(uint8_t addr, TwoWire *theWire = &Wire)
+        : _addr(addr), _wire(theWire) {}
+
+    uint8_t address(void) { return _addr; }
+    bool begin(bool addr_detect = true) {
+        (void)addr_detect;
+        return true;
+    }
+    bool detected(void) { return true; }
+    bool write(const uint8_t *buffer, size_t len, bool stop = true,
+               const uint8_t *prefix_buffer = nullptr, size_t prefix_len = 0);
+    size_t maxBufferSize() { return _maxBufferSize; }
+
+  private:
+    uint8_t _addr;
+    TwoWire *_wire;
+    size_t _maxBufferSize = 32; // same as the ESP8266 Wire library
+};
+
+#endif
@@ -0,0 +1,197 @@
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+// Just enough of the ESP8266 Arduino core to build the firmware on the
+// host. Time is virtual: it only moves through delay() and simulated bus /
+// radio activity, see sim/src/arduino.cpp.
+
+#include <algorithm>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+#include "pgmspace.h"
+
+// the default CPU clock of the board, set by the build on the device
+#ifndef F_CPU
+#define F_CPU 80000000L
+#endif
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0x00
+#define OUTPUT 0x01
+#define INPUT_PULLUP 0x02
+#define OUTPUT_OPEN_DRAIN 0x03
+
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+#define HEX 16
+#define DEC 10
+
+#define PI 3.1415926535897932384626433832795
+
+#define IRAM_ATTR
+#define ICACHE_RAM_ATTR
+
+// NodeMCU pin names
+#define D0 16
+#define D1 5
+#define D2 4
+#define D3 0
+#define D4 2
+#define D5 14
+#define D6 12
+#define D7 13
+#define D8 15
+#define A0 17
+
+using std::max;
+using std::min;
+
+#define constrain(amt, low, high)                                              \
+    ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+#define interrupts()
+#define noInterrupts()
+#define digitalPinToInterrupt(pin) (pin)
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+int analogRead(uint8_t pin);
+void attachInterrupt(uint8_t pin, void (*isr)(), int mode);
+void detachInterrupt(uint8_t pin);
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(s))
+
+class String {
+  public:
+    String(const char *s = "") : str(s ? s : "") {}
+    String(char c) : str(1, c) {}
+    String(int value) : str(std::to_string(value)) {}
+    String(const std::string &s) : str(s) {}
+
+    const char *c_str() const { return str.c_str(); }
+    unsigned int length() const { return str.size(); }
+    char charAt(unsigned int i) const { return i < str.size() ? str[i] : 0; }
+    char operator[](unsigned int i) const { return charAt(i); }
+
+    String &operator+=(const String &other) {
+        str += other.str;
+        return *this;
+    }
+    String &operator+=(char c) {
+        str += c;
+        return *this;
+    }
+    friend String operator+(const String &a, const String &b) {
+        return String(a.str + b.str);
+    }
+    friend String operator+(const String &a, const char *b) {
+        return String(a.str + b);
+    }
+    friend String operator+(const String &a, char b) {
+        return String(a.str + b);
+    }
+    bool operator==(const String &other) const { return str == other.str; }
+    bool operator!=(const String &other) const { return str != other.str; }
+
+  private:
+    std::string str;
+};
+
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buf, size_t len) {
+        size_t n = 0;
+        while (len--) {
+            n += write(*buf++);
+        }
+        return n;
+    }
+    size_t write(const char *s) {
+        return s ? write((const uint8_t *)s, strlen(s)) : 0;
+    }
+
+    size_t print(const char *s) { return write(s); }
+    size_t print(const __FlashStringHelper *s) {
+        return write((const char *)s);
+    }
+    size_t print(const String &s) { return write(s.c_str()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char value, int base = DEC) {
+        return print((unsigned long)value, base);
+    }
+    size_t print(int value, int base = DEC) {
+        return print((long)value, base);
+    }
+    size_t print(unsigned int value, int base = DEC) {
+        return print((unsigned long)value, base);
+    }
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(double value, int digits = 2);
+
+    size_t println() { return write("\r\n"); }
+    template <typename T> size_t println(const T &value) {
+        size_t n = print(value);
+        return n + println();
+    }
+    template <typename T> size_t println(const T &value, int base) {
+        size_t n = print(value, base);
+        return n + println();
+    }
+    size_t printf(const char *format, ...)
+        __attribute__((format(printf, 2, 3)));
+};
+
+class HardwareSerial : public Print {
+  public:
+    void begin(unsigned long baud) { (void)baud; }
+    size_t write(uint8_t c) override;
+    using Print::write;
+    int available() { return 0; }
+    int read() { return -1; }
+    operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#define SPI_FLASH_SEC_SIZE 4096
+
+#define ADC_VCC 1
+#define ADC_MODE(mode)
+
+class EspClass {
+  public:
+    uint32_t getCycleCount();
+    uint32_t getCpuFreqMHz() { return F_CPU / 1000000; }
+    uint32_t getFreeHeap() { return 40000; }
+    uint16_t getVcc() { return 3280; }
+    void restart() {}
+    bool flashEraseSector(uint32_t sector);
+    bool flashWrite(uint32_t offset, const uint32_t *data, size_t size);
+    bool flashRead(uint32_t offset, uint32_t *data, size_t size);
+};
+
+extern EspClass ESP;
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef WiFi_h
+#define WiFi_h
+
+#include <Arduino.h>
+
+extern "C" {
+#include "user_interface.h"
+}
+
+enum WiFiMode { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 };
+typedef WiFiMode WiFiMode_t;
+
+enum wl_enc_type {
+    ENC_TYPE_WEP = 5,
+    ENC_TYPE_TKIP = 2,
+    ENC_TYPE_CCMP = 4,
+    ENC_TYPE_NONE = 7,
+    ENC_TYPE_AUTO = 8
+};
+
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED (-2)
+
+// Scans return the access points listed in sim/src/wifi.cpp after the
+// same per-channel dwell the real radio needs
+class ESP8266WiFiClass {
+  public:
+    bool mode(WiFiMode_t m) {
+        _mode = m;
+        return true;
+    }
+    WiFiMode_t getMode() { return _mode; }
+    bool disconnect(bool wifioff = false) {
+        (void)wifioff;
+        return true;
+    }
+    void persistent(bool persistent) { (void)persistent; }
+
+    int8_t scanNetworks(bool async = false, bool show_hidden = false,
+                        uint8 channel = 0, uint8 *ssid = NULL);
+    int8_t scanComplete();
+    void scanDelete();
+
+    String SSID(uint8_t i);
+    uint8_t encryptionType(uint8_t i);
+    int32_t RSSI(uint8_t i);
+    uint8_t *BSSID(uint8_t i);
+    int32_t channel(uint8_t i);
+    bool isHidden(uint8_t i);
+    const bss_info *getScanInfoByIndex(int i);
+
+  private:
+    WiFiMode_t _mode = WIFI_OFF;
+};
+
+extern ESP8266WiFiClass WiFi;
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef TwoWire_h
+#define TwoWire_h
+
+#include <Arduino.h>
+#include <twi.h>
+
+#define BUFFER_LENGTH 128
+
+// A thin layer over twi like the core's, so the clock is shared with
+// direct twi users
+class TwoWire {
+  public:
+    void begin(int sda, int scl) { twi_init(sda, scl); }
+    void begin() {}
+    void setClock(uint32_t frequency) { twi_setClock(frequency); }
+
+    void beginTransmission(uint8_t address) {
+        txAddress = address;
+        txLength = 0;
+    }
+    size_t write(uint8_t data) {
+        if (txLength >= BUFFER_LENGTH) {
+            return 0;
+        }
+        txBuffer[txLength++] = data;
+        return 1;
+    }
+    size_t write(const uint8_t *data, size_t len) {
+        size_t n = 0;
+        while (len--) {
+            n += write(*data++);
+        }
+        return n;
+    }
+    uint8_t endTransmission(bool stop = true);
+
+  private:
+    uint8_t txAddress = 0;
+    uint8_t txBuffer[BUFFER_LENGTH];
+    size_t txLength = 0;
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef FLASH_HAL_H
+#define FLASH_HAL_H
+
+// The filesystem area of the 4M2M layout, shortened to what the simulated
+// flash covers (see sim/src/flash.cpp).
+#define FS_PHYS_ADDR 0x200000
+#define FS_PHYS_SIZE 0x10000
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef _GPIO_H_
+#define _GPIO_H_
+
+// SDK GPIO wakeup calls used for light sleep, see sim/src/power.cpp
+
+#include "user_interface.h"
+
+#define GPIO_ID_PIN(n) (n)
+
+typedef enum {
+    GPIO_PIN_INTR_DISABLE = 0,
+    GPIO_PIN_INTR_POSEDGE = 1,
+    GPIO_PIN_INTR_NEGEDGE = 2,
+    GPIO_PIN_INTR_ANYEDGE = 3,
+    GPIO_PIN_INTR_LOLEVEL = 4,
+    GPIO_PIN_INTR_HILEVEL = 5
+} GPIO_INT_TYPE;
+
+void gpio_pin_wakeup_enable(uint32 i, GPIO_INT_TYPE intr_state);
+void gpio_pin_wakeup_disable(void);
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef SI2C_h
+#define SI2C_h
+
+#include <stdint.h>
+
+// The core's bit-banged I2C master, which Wire is built on. Here both end
+// up on the simulated SH1106, see sim/src/sh110x.cpp.
+
+#define I2C_OK 0
+#define I2C_SCL_HELD_LOW 1
+#define I2C_SCL_HELD_LOW_AFTER_READ 2
+#define I2C_SDA_HELD_LOW 3
+#define I2C_SDA_HELD_LOW_AFTER_INIT 4
+
+void twi_init(unsigned char sda, unsigned char scl);
+void twi_stop(void);
+void twi_setClock(unsigned int freq);
+void twi_setClockStretchLimit(uint32_t limit);
+uint8_t twi_writeTo(unsigned char address, unsigned char *buf,
+                    unsigned int len, unsigned char sendStop);
+uint8_t twi_readFrom(unsigned char address, unsigned char *buf,
+                     unsigned int len, unsigned char sendStop);
+uint8_t twi_status();
+
+#endif
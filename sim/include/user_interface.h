@@ -0,0 +1,67 @@
+#ifndef __USER_INTERFACE_H__
+#define __USER_INTERFACE_H__
+
+// The parts of the NONOS SDK the firmware calls directly
+
+#include <stdint.h>
+
+typedef uint8_t uint8;
+typedef int8_t sint8;
+typedef uint16_t uint16;
+typedef int16_t sint16;
+typedef uint32_t uint32;
+typedef int32_t sint32;
+
+typedef enum {
+    AUTH_OPEN = 0,
+    AUTH_WEP,
+    AUTH_WPA_PSK,
+    AUTH_WPA2_PSK,
+    AUTH_WPA_WPA2_PSK,
+    AUTH_MAX
+} AUTH_MODE;
+
+struct bss_info {
+    void *next;
+    uint8 bssid[6];
+    uint8 ssid[32];
+    uint8 ssid_len;
+    uint8 channel;
+    sint8 rssi;
+    AUTH_MODE authmode;
+    uint8 is_hidden;
+    sint16 freq_offset;
+    sint16 freqcal_val;
+    uint8 *esp_mesh_ie;
+    uint8 simple_pair;
+};
+
+typedef void (*wifi_promiscuous_cb_t)(uint8 *buf, uint16 len);
+
+void wifi_set_promiscuous_rx_cb(wifi_promiscuous_cb_t cb);
+void wifi_promiscuous_enable(uint8 promiscuous);
+bool wifi_set_channel(uint8 channel);
+uint8 wifi_get_channel(void);
+
+// forced light sleep
+#define FPM_SLEEP_MAX_TIME 0xFFFFFFF
+
+typedef enum sleep_type {
+    NONE_SLEEP_T = 0,
+    LIGHT_SLEEP_T,
+    MODEM_SLEEP_T
+} sleep_type_t;
+
+typedef void (*fpm_wakeup_cb)(void);
+
+void wifi_fpm_open(void);
+void wifi_fpm_close(void);
+sint8 wifi_fpm_do_sleep(uint32 sleep_time_in_us);
+void wifi_fpm_set_sleep_type(sleep_type_t type);
+void wifi_fpm_set_wakeup_cb(fpm_wakeup_cb cb);
+
+// RTC clock, keeps running in light sleep
+uint32 system_get_rtc_time(void);
+uint32 system_rtc_clock_cali_proc(void);
+
+#endif
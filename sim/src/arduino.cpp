@@ -0,0 +1,138 @@
+#include <Arduino.h>
+#include <chrono>
+#include <stdarg.h>
+
+#include "sim.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+
+constexpr uint8_t SIM_PINS = 32;
+
+static uint64_t nowUs = 0;
+static bool pinLow[SIM_PINS];
+static void (*pinIsr[SIM_PINS])();
+
+uint64_t simNow() { return nowUs; }
+
+void simAdvance(uint64_t us) { nowUs += us; }
+
+/**
+ * @brief Changes a button line and fires its interrupt handler, if any
+ */
+void simSetPin(uint8_t pin, bool low) {
+    if (pin >= SIM_PINS || pinLow[pin] == low) {
+        return;
+    }
+
+    pinLow[pin] = low;
+    simWakePin(pin, low);
+    if (pinIsr[pin]) {
+        pinIsr[pin]();
+    }
+}
+
+unsigned long millis() { return nowUs / 1000; }
+
+unsigned long micros() { return (unsigned long)nowUs; }
+
+void delay(unsigned long ms) { nowUs += (uint64_t)ms * 1000; }
+
+void delayMicroseconds(unsigned int us) { nowUs += us; }
+
+void yield() {}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    (void)pin;
+    (void)mode;
+}
+
+int digitalRead(uint8_t pin) {
+    return pin < SIM_PINS && pinLow[pin] ? LOW : HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    (void)pin;
+    (void)value;
+}
+
+int analogRead(uint8_t pin) {
+    (void)pin;
+    return 0;
+}
+
+void attachInterrupt(uint8_t pin, void (*isr)(), int mode) {
+    (void)mode;
+    if (pin < SIM_PINS) {
+        pinIsr[pin] = isr;
+    }
+}
+
+void detachInterrupt(uint8_t pin) {
+    if (pin < SIM_PINS) {
+        pinIsr[pin] = nullptr;
+    }
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    if (!simQuiet) {
+        fputc(c, stdout);
+    }
+    return 1;
+}
+
+size_t Print::print(long value, int base) {
+    if (value < 0 && base == DEC) {
+        return print('-') + print((unsigned long)-value, base);
+    }
+    return print((unsigned long)value, base);
+}
+
+size_t Print::print(unsigned long value, int base) {
+    char buf[8 * sizeof(long) + 1];
+    char *p = buf + sizeof(buf) - 1;
+    *p = '\0';
+
+    if (base < 2) {
+        base = 10;
+    }
+    do {
+        uint8_t digit = value % base;
+        *--p = digit < 10 ? '0' + digit : 'A' + digit - 10;
+        value /= base;
+    } while (value);
+
+    return write(p);
+}
+
+size_t Print::print(double value, int digits) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.*f", digits, value);
+    return write(buf);
+}
+
+size_t Print::printf(const char *format, ...) {
+    char buf[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    return write(buf);
+}
+
+static const std::chrono::steady_clock::time_point hostStart =
+    std::chrono::steady_clock::now();
+
+/**
+ * @brief Cycles at the ESP8266's default 80 MHz
+ *
+ * Counts the virtual time (bus transfers, delays) plus the host time really
+ * spent, so drawing code that takes no virtual time still shows up. The
+ * host part is only good for comparing host runs with each other.
+ */
+uint32_t EspClass::getCycleCount() {
+    auto host = std::chrono::steady_clock::now() - hostStart;
+    uint64_t hostNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(host).count();
+    return (uint32_t)(nowUs * 80 + hostNs * 80 / 1000);
+}
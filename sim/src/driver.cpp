@@ -0,0 +1,152 @@
+#include <Arduino.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "sim.h"
+
+// Runs the firmware headless and replays a button script against it:
+//
+//   wait MS        run loop() for MS ms of virtual time
+//   press BTN      short press of UP, DOWN, OK or BACK
+//   hold BTN MS    keep BTN down for MS ms
+//   down BTN       push BTN and leave it down (for chords)
+//   up BTN         release BTN
+//   snap FILE      save the panel as a PBM image
+//   show           print the panel to stderr
+//   stats          print time and I2C traffic so far to stderr
+//
+// The script comes from the command line, or from stdin when there is none.
+// -q silences Serial output.
+
+void setup();
+void loop();
+
+SimStats simStats = {0, 0, 0, 0};
+bool simQuiet = false;
+
+constexpr unsigned long PRESS_MS = 60;
+constexpr unsigned long RELEASE_MS = 40;
+
+/**
+ * @brief Runs loop() until `ms` of virtual time have passed
+ *
+ * A pass that takes no simulated time (nothing on the bus, no delay) still
+ * counts as 1 ms, so an idle loop() cannot stall the clock. In light sleep
+ * loop() doesn't run at all, time just passes until a wakeup pin goes low.
+ */
+static void runFor(unsigned long ms) {
+    uint64_t end = simNow() + (uint64_t)ms * 1000;
+
+    while (simNow() < end) {
+        if (simSleeping()) {
+            simAdvance(1000);
+            simStats.sleepMs++;
+            continue;
+        }
+
+        uint64_t before = simNow();
+        loop();
+        simRadioTick();
+        simStats.loops++;
+        if (simNow() == before) {
+            simAdvance(1000);
+        }
+    }
+}
+
+static int buttonPin(const std::string &name) {
+    if (name == "UP") {
+        return BTN_UP;
+    }
+    if (name == "DOWN") {
+        return BTN_DOWN;
+    }
+    if (name == "OK") {
+        return BTN_OK;
+    }
+    if (name == "BACK") {
+        return BTN_BACK;
+    }
+    return -1;
+}
+
+static void pressButton(uint8_t pin, unsigned long ms) {
+    simSetPin(pin, true);
+    runFor(ms);
+    simSetPin(pin, false);
+    runFor(RELEASE_MS);
+}
+
+static void printStats() {
+    fprintf(stderr,
+            "t=%lums loops=%lu i2c_bytes=%lu transactions=%lu "
+            "sleep=%lums\n",
+            millis(), simStats.loops, simStats.i2cBytes,
+            simStats.i2cTransactions, simStats.sleepMs);
+}
+
+int main(int argc, char **argv) {
+    std::vector<std::string> script;
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "-q") {
+            simQuiet = true;
+        } else {
+            script.push_back(argv[i]);
+        }
+    }
+    if (script.empty()) {
+        std::string word;
+        while (std::cin >> word) {
+            script.push_back(word);
+        }
+    }
+
+    setup();
+
+    size_t i = 0;
+    auto next = [&]() -> std::string {
+        return i < script.size() ? script[i++] : std::string();
+    };
+
+    while (i < script.size()) {
+        std::string command = next();
+
+        if (command == "wait") {
+            runFor(strtoul(next().c_str(), nullptr, 10));
+        } else if (command == "press" || command == "hold") {
+            int pin = buttonPin(next());
+            unsigned long ms = PRESS_MS;
+            if (command == "hold") {
+                ms = strtoul(next().c_str(), nullptr, 10);
+            }
+            if (pin < 0) {
+                fprintf(stderr, "unknown button\n");
+                return 1;
+            }
+            pressButton(pin, ms);
+        } else if (command == "down" || command == "up") {
+            int pin = buttonPin(next());
+            if (pin < 0) {
+                fprintf(stderr, "unknown button\n");
+                return 1;
+            }
+            simSetPin(pin, command == "down");
+        } else if (command == "snap") {
+            std::string path = next();
+            if (!simWritePBM(path.c_str())) {
+                fprintf(stderr, "cannot write %s\n", path.c_str());
+                return 1;
+            }
+        } else if (command == "show") {
+            simPrintPanel();
+        } else if (command == "stats") {
+            printStats();
+        } else {
+            fprintf(stderr, "unknown command: %s\n", command.c_str());
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include <Arduino.h>
+#include <flash_hal.h>
+
+// Only the filesystem area exists. Like NOR flash, an erase sets every bit
+// of a sector and a write can only clear bits. With KVDAN_FLASH set to a
+// file name the contents survive between runs.
+
+static uint8_t flash[FS_PHYS_SIZE];
+static bool loaded = false;
+
+static const char *flashFile() { return getenv("KVDAN_FLASH"); }
+
+static void load() {
+    if (loaded) {
+        return;
+    }
+    loaded = true;
+    memset(flash, 0xFF, sizeof(flash));
+
+    const char *path = flashFile();
+    FILE *file = path ? fopen(path, "rb") : nullptr;
+    if (file) {
+        size_t got = fread(flash, 1, sizeof(flash), file);
+        (void)got;
+        fclose(file);
+    }
+}
+
+static void store() {
+    const char *path = flashFile();
+    FILE *file = path ? fopen(path, "wb") : nullptr;
+    if (file) {
+        fwrite(flash, 1, sizeof(flash), file);
+        fclose(file);
+    }
+}
+
+// offset into the simulated area, or -1 when outside or misaligned
+static long locate(uint32_t offset, size_t size) {
+    if (offset < FS_PHYS_ADDR || offset % 4 || size % 4 ||
+        offset - FS_PHYS_ADDR + size > sizeof(flash)) {
+        return -1;
+    }
+    return offset - FS_PHYS_ADDR;
+}
+
+bool EspClass::flashEraseSector(uint32_t sector) {
+    long at = locate(sector * SPI_FLASH_SEC_SIZE, SPI_FLASH_SEC_SIZE);
+    if (at < 0) {
+        return false;
+    }
+    load();
+    memset(flash + at, 0xFF, SPI_FLASH_SEC_SIZE);
+    store();
+    return true;
+}
+
+bool EspClass::flashWrite(uint32_t offset, const uint32_t *data, size_t size) {
+    long at = locate(offset, size);
+    if (at < 0) {
+        return false;
+    }
+    load();
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (size_t i = 0; i < size; i++) {
+        flash[at + i] &= bytes[i];
+    }
+    store();
+    return true;
+}
+
+bool EspClass::flashRead(uint32_t offset, uint32_t *data, size_t size) {
+    long at = locate(offset, size);
+    if (at < 0) {
+        return false;
+    }
+    load();
+    memcpy(data, flash + at, size);
+    return true;
+}
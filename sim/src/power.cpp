@@ -0,0 +1,60 @@
+#include <Arduino.h>
+
+extern "C" {
+#include <gpio.h>
+}
+
+#include "sim.h"
+
+// Forced light sleep. The virtual clock keeps running while asleep (the
+// driver has to advance it to get to the next button press), only the
+// firmware's view changes: wifi_fpm_do_sleep() arms it and the wakeup
+// callback runs once an armed pin is pulled low.
+
+constexpr uint8_t SIM_PINS = 32;
+
+static bool fpmOpen = false;
+static sleep_type_t sleepType = NONE_SLEEP_T;
+static fpm_wakeup_cb wakeupCb = nullptr;
+static bool wakePins[SIM_PINS];
+static bool sleeping = false;
+
+void wifi_fpm_open(void) { fpmOpen = true; }
+void wifi_fpm_close(void) { fpmOpen = false; }
+void wifi_fpm_set_sleep_type(sleep_type_t type) { sleepType = type; }
+void wifi_fpm_set_wakeup_cb(fpm_wakeup_cb cb) { wakeupCb = cb; }
+
+sint8 wifi_fpm_do_sleep(uint32 sleep_time_in_us) {
+    (void)sleep_time_in_us;
+    if (!fpmOpen || sleepType != LIGHT_SLEEP_T) {
+        return -1;
+    }
+    sleeping = true;
+    return 0;
+}
+
+void gpio_pin_wakeup_enable(uint32 i, GPIO_INT_TYPE intr_state) {
+    if (i < SIM_PINS) {
+        wakePins[i] = intr_state == GPIO_PIN_INTR_LOLEVEL;
+    }
+}
+
+void gpio_pin_wakeup_disable(void) {
+    memset(wakePins, 0, sizeof(wakePins));
+}
+
+// one tick per µs
+uint32 system_get_rtc_time(void) { return (uint32)simNow(); }
+uint32 system_rtc_clock_cali_proc(void) { return 1 << 12; }
+
+bool simSleeping() { return sleeping; }
+
+void simWakePin(uint8_t pin, bool low) {
+    if (!sleeping || !low || pin >= SIM_PINS || !wakePins[pin]) {
+        return;
+    }
+    sleeping = false;
+    if (wakeupCb) {
+        wakeupCb();
+    }
+}
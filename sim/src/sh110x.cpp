@@ -0,0 +1,393 @@
+#include <Adafruit_SH110X.h>
+
+#include "sim.h"
+
+TwoWire Wire;
+
+constexpr uint8_t PANEL_ADDRESS = 0x3C;
+constexpr uint8_t PANEL_COLUMNS = 132; // SH1106 RAM is wider than the glass
+constexpr uint8_t PANEL_PAGES = 8;
+constexpr uint8_t PANEL_COLUMN_OFFSET = 2;
+
+// SH1106 controller state, fed by whatever goes over the bus
+struct Panel {
+    uint8_t ram[PANEL_PAGES][PANEL_COLUMNS];
+    uint8_t page;
+    uint8_t column;
+    uint8_t startLine;
+    uint8_t contrast;
+    bool on;
+    uint8_t command;     // last command byte that takes an argument
+    uint8_t pendingArgs; // argument bytes still expected for it
+};
+
+static Panel panel = {{}, 0, 0, 0, 0x80, false, 0, 0};
+
+static uint8_t commandArgs(uint8_t c) {
+    switch (c) {
+    case SH110X_SETCONTRAST:
+    case SH110X_CHARGEPUMP:
+    case SH110X_SETMULTIPLEX:
+    case SH110X_DCDC:
+    case SH110X_SETDISPLAYOFFSET:
+    case SH110X_SETDISPLAYCLOCKDIV:
+    case SH110X_SETPRECHARGE:
+    case SH110X_SETCOMPINS:
+    case SH110X_SETVCOMDETECT:
+    case SH110X_SETDISPSTARTLINE:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static void panelCommand(uint8_t c) {
+    if (panel.pendingArgs) {
+        panel.pendingArgs--;
+        if (panel.command == SH110X_SETCONTRAST) {
+            panel.contrast = c;
+        }
+        return;
+    }
+
+    if ((c & 0xF0) == SH110X_SETPAGEADDR) {
+        panel.page = c & 0x07;
+    } else if (c <= 0x0F) {
+        panel.column = (panel.column & 0xF0) | c;
+    } else if (c <= 0x1F) {
+        panel.column = (panel.column & 0x0F) | ((c & 0x0F) << 4);
+    } else if ((c & 0xC0) == SH110X_SETSTARTLINE) {
+        panel.startLine = c & 0x3F;
+    } else if (c == SH110X_DISPLAYOFF) {
+        panel.on = false;
+    } else if (c == SH110X_DISPLAYON) {
+        panel.on = true;
+    }
+
+    panel.command = c;
+    panel.pendingArgs = commandArgs(c);
+}
+
+static void panelData(uint8_t d) {
+    // the column pointer stops at the end of the RAM instead of wrapping
+    if (panel.column < PANEL_COLUMNS) {
+        panel.ram[panel.page][panel.column++] = d;
+    }
+}
+
+/**
+ * @brief Runs one I2C transaction and charges its bus time to the clock
+ *
+ * The payload is parsed like the SH1106 does: a control byte with Co set
+ * is followed by a single command/data byte, with Co clear the rest of the
+ * transaction is commands (D/C clear) or display data (D/C set).
+ *
+ * @return Wire style status, 2 (address NACK) for anything but the panel
+ */
+uint8_t simI2CTransfer(uint8_t address, const uint8_t *data, size_t len,
+                       uint32_t clock) {
+    if (address != PANEL_ADDRESS) {
+        return 2;
+    }
+
+    // start + stop plus 9 clocks per byte, address included
+    simAdvance((uint64_t)(len + 1) * 9 * 1000000 / clock + 5);
+    simStats.i2cBytes += len;
+    simStats.i2cTransactions++;
+
+    size_t i = 0;
+    while (i < len) {
+        uint8_t control = data[i++];
+        bool isData = control & 0x40;
+        bool continuation = control & 0x80;
+        size_t end = continuation ? (i < len ? i + 1 : i) : len;
+
+        for (; i < end; i++) {
+            if (isData) {
+                panelData(data[i]);
+            } else {
+                panelCommand(data[i]);
+            }
+        }
+    }
+    return 0;
+}
+
+bool simPanelOn() { return panel.on; }
+
+bool simPanelPixel(int x, int y) {
+    if (!panel.on) {
+        return false;
+    }
+    uint8_t line = (y + panel.startLine) & 0x3F;
+    uint8_t column = x + PANEL_COLUMN_OFFSET;
+    return panel.ram[line >> 3][column] & (1 << (line & 7));
+}
+
+/**
+ * @brief Writes the visible panel as a plain (P1) PBM image
+ */
+bool simWritePBM(const char *path) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        return false;
+    }
+
+    fprintf(f, "P1\n128 64\n");
+    for (int y = 0; y < 64; y++) {
+        for (int x = 0; x < 128; x++) {
+            fputc(simPanelPixel(x, y) ? '1' : '0', f);
+        }
+        fputc('\n', f);
+    }
+    fclose(f);
+    return true;
+}
+
+/**
+ * @brief Prints the visible panel to stderr, two pixel rows per line
+ */
+void simPrintPanel() {
+    static const char *const cells[] = {" ", "▀", "▄", "█"};
+
+    for (int y = 0; y < 64; y += 2) {
+        for (int x = 0; x < 128; x++) {
+            int cell = simPanelPixel(x, y) | simPanelPixel(x, y + 1) << 1;
+            fputs(cells[cell], stderr);
+        }
+        fputc('\n', stderr);
+    }
+}
+
+uint8_t TwoWire::endTransmission(bool stop) {
+    uint8_t status = twi_writeTo(txAddress, txBuffer, txLength, stop);
+    txLength = 0;
+    return status;
+}
+
+static uint32_t twiClock = 100000;
+static unsigned long twiTransfers = 0;
+
+// KVDAN_I2C_FAULTS=n: every nth transaction is NACKed, to exercise the
+// firmware's error handling
+static unsigned long faultInterval() {
+    static long interval = -1;
+    if (interval < 0) {
+        const char *env = getenv("KVDAN_I2C_FAULTS");
+        interval = env ? atol(env) : 0;
+    }
+    return interval;
+}
+
+void twi_init(unsigned char sda, unsigned char scl) {
+    (void)sda;
+    (void)scl;
+}
+
+void twi_stop(void) {}
+
+// the core's limits: 400 kHz at 80 MHz, 800 kHz at 160 MHz
+void twi_setClock(unsigned int freq) {
+    twiClock = min(freq, F_CPU >= 160000000L ? 800000u : 400000u);
+}
+
+void twi_setClockStretchLimit(uint32_t limit) { (void)limit; }
+
+uint8_t twi_writeTo(unsigned char address, unsigned char *buf,
+                    unsigned int len, unsigned char sendStop) {
+    (void)sendStop;
+    unsigned long interval = faultInterval();
+    if (interval && ++twiTransfers % interval == 0) {
+        simAdvance(10);
+        return 3; // data NACK
+    }
+    return simI2CTransfer(address, buf, len, twiClock);
+}
+
+uint8_t twi_readFrom(unsigned char address, unsigned char *buf,
+                     unsigned int len, unsigned char sendStop) {
+    (void)address;
+    (void)buf;
+    (void)len;
+    (void)sendStop;
+    return 2;
+}
+
+uint8_t twi_status() { return I2C_OK; }
+
+bool Adafruit_I2CDevice::write(const uint8_t *buffer, size_t len, bool stop,
+                               const uint8_t *prefix_buffer,
+                               size_t prefix_len) {
+    if (len + prefix_len > _maxBufferSize) {
+        return false;
+    }
+
+    _wire->beginTransmission(_addr);
+    _wire->write(prefix_buffer, prefix_len);
+    _wire->write(buffer, len);
+    return _wire->endTransmission(stop) == 0;
+}
+
+Adafruit_GrayOLED::Adafruit_GrayOLED(uint8_t bpp, uint16_t w, uint16_t h,
+                                     TwoWire *twi, int8_t rst_pin,
+                                     uint32_t preclk, uint32_t postclk)
+    : Adafruit_GFX(w, h), _theWire(twi), rstPin(rst_pin), _bpp(bpp),
+      i2c_preclk(preclk), i2c_postclk(postclk) {}
+
+Adafruit_GrayOLED::~Adafruit_GrayOLED(void) {
+    free(buffer);
+    delete i2c_dev;
+}
+
+bool Adafruit_GrayOLED::_init(uint8_t addr, bool reset) {
+    (void)reset;
+
+    buffer = (uint8_t *)malloc(WIDTH * ((HEIGHT + 7) / 8));
+    if (!buffer) {
+        return false;
+    }
+    i2c_dev = new Adafruit_I2CDevice(addr, _theWire);
+    _theWire->setClock(i2c_preclk);
+
+    clearDisplay();
+    return true;
+}
+
+void Adafruit_GrayOLED::clearDisplay(void) {
+    memset(buffer, 0, WIDTH * ((HEIGHT + 7) / 8));
+    window_x1 = 0;
+    window_y1 = 0;
+    window_x2 = WIDTH - 1;
+    window_y2 = HEIGHT - 1;
+}
+
+void Adafruit_GrayOLED::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (x < 0 || y < 0 || x >= width() || y >= height()) {
+        return;
+    }
+
+    uint8_t *ptr = &buffer[x + (y / 8) * WIDTH];
+    uint8_t bit = 1 << (y & 7);
+    switch (color) {
+    case MONOOLED_WHITE:
+        *ptr |= bit;
+        break;
+    case MONOOLED_BLACK:
+        *ptr &= ~bit;
+        break;
+    case MONOOLED_INVERSE:
+        *ptr ^= bit;
+        break;
+    }
+
+    window_x1 = min(window_x1, x);
+    window_y1 = min(window_y1, y);
+    window_x2 = max(window_x2, x);
+    window_y2 = max(window_y2, y);
+}
+
+bool Adafruit_GrayOLED::getPixel(int16_t x, int16_t y) {
+    if (x < 0 || y < 0 || x >= width() || y >= height()) {
+        return false;
+    }
+    return buffer[x + (y / 8) * WIDTH] & (1 << (y & 7));
+}
+
+void Adafruit_GrayOLED::oled_command(uint8_t c) {
+    uint8_t buf[2] = {0x00, c};
+    i2c_dev->write(buf, sizeof(buf));
+}
+
+bool Adafruit_GrayOLED::oled_commandList(const uint8_t *c, uint8_t n) {
+    uint8_t dcByte = 0x00;
+    return i2c_dev->write(c, n, true, &dcByte, 1);
+}
+
+void Adafruit_GrayOLED::invertDisplay(bool i) {
+    oled_command(i ? GRAYOLED_INVERTDISPLAY : GRAYOLED_NORMALDISPLAY);
+}
+
+void Adafruit_GrayOLED::setContrast(uint8_t level) {
+    uint8_t cmd[] = {GRAYOLED_SETCONTRAST, level};
+    oled_commandList(cmd, sizeof(cmd));
+}
+
+Adafruit_SH110X::Adafruit_SH110X(uint16_t w, uint16_t h, TwoWire *twi,
+                                 int8_t rst_pin, uint32_t preclk,
+                                 uint32_t postclk)
+    : Adafruit_GrayOLED(1, w, h, twi, rst_pin, preclk, postclk) {}
+
+Adafruit_SH110X::~Adafruit_SH110X(void) {}
+
+// same transfer pattern as the library: a page/column command per page,
+// then the dirty window in maxBufferSize()-1 byte data chunks
+void Adafruit_SH110X::display(void) {
+    uint8_t dcByte = 0x40;
+    uint8_t pages = (HEIGHT + 7) / 8;
+    uint8_t firstPage = window_y1 / 8;
+    uint8_t pageStart = min((int16_t)WIDTH, window_x1);
+    uint8_t pageEnd = (uint8_t)max((int16_t)0, window_x2);
+    uint8_t maxChunk = i2c_dev->maxBufferSize() - 1;
+
+    for (uint8_t p = firstPage; p < pages; p++) {
+        uint8_t *ptr = buffer + p * WIDTH + pageStart;
+        uint8_t remaining = WIDTH - pageStart - ((WIDTH - 1) - pageEnd);
+        uint8_t column = pageStart + _page_start_offset;
+        uint8_t cmd[] = {0x00, (uint8_t)(SH110X_SETPAGEADDR + p),
+                         (uint8_t)(0x10 + (column >> 4)),
+                         (uint8_t)(column & 0xF)};
+        i2c_dev->write(cmd, sizeof(cmd));
+
+        while (remaining) {
+            uint8_t chunk = min(remaining, maxChunk);
+            i2c_dev->write(ptr, chunk, true, &dcByte, 1);
+            ptr += chunk;
+            remaining -= chunk;
+        }
+    }
+
+    window_x1 = 1024;
+    window_y1 = 1024;
+    window_x2 = -1;
+    window_y2 = -1;
+}
+
+Adafruit_SH1106G::Adafruit_SH1106G(uint16_t w, uint16_t h, TwoWire *twi,
+                                   int8_t rst_pin, uint32_t preclk,
+                                   uint32_t postclk)
+    : Adafruit_SH110X(w, h, twi, rst_pin, preclk, postclk) {}
+
+Adafruit_SH1106G::~Adafruit_SH1106G(void) {}
+
+bool Adafruit_SH1106G::begin(uint8_t addr, bool reset) {
+    _page_start_offset = PANEL_COLUMN_OFFSET;
+
+    if (!_init(addr, reset)) {
+        return false;
+    }
+
+    // the library's SH1106 init sequence
+    static const uint8_t init[] = {
+        SH110X_DISPLAYOFF,
+        SH110X_SETDISPLAYCLOCKDIV, 0x80,
+        SH110X_SETMULTIPLEX, 0x3F,
+        SH110X_SETDISPLAYOFFSET, 0x00,
+        SH110X_SETSTARTLINE,
+        SH110X_DCDC, 0x8B,
+        SH110X_SEGREMAP + 1,
+        SH110X_COMSCANDEC,
+        SH110X_SETCOMPINS, 0x12,
+        SH110X_SETCONTRAST, 0xFF,
+        SH110X_SETPRECHARGE, 0x1F,
+        SH110X_SETVCOMDETECT, 0x40,
+        0x33,
+        SH110X_NORMALDISPLAY,
+    };
+    if (!oled_commandList(init, sizeof(init))) {
+        return false;
+    }
+
+    delay(100);
+    oled_command(SH110X_DISPLAYON);
+    return true;
+}
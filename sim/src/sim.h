@@ -0,0 +1,41 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// virtual clock, only moves when something takes time
+uint64_t simNow();
+void simAdvance(uint64_t us);
+
+// buttons: low = pressed, like the INPUT_PULLUP wiring on the board
+void simSetPin(uint8_t pin, bool low);
+
+// one I2C transaction (START, address, payload, STOP)
+uint8_t simI2CTransfer(uint8_t address, const uint8_t *data, size_t len,
+                       uint32_t clock);
+
+// what the SH1106 currently shows
+bool simPanelOn();
+bool simPanelPixel(int x, int y);
+bool simWritePBM(const char *path);
+void simPrintPanel();
+
+// light sleep: a wakeup pin going low ends it
+bool simSleeping();
+void simWakePin(uint8_t pin, bool low);
+
+// delivers sniffer frames while promiscuous mode is on
+void simRadioTick();
+
+struct SimStats {
+    unsigned long i2cBytes;
+    unsigned long i2cTransactions;
+    unsigned long loops;
+    unsigned long sleepMs; // spent in light sleep
+};
+
+extern SimStats simStats;
+extern bool simQuiet;
+
+#endif
@@ -0,0 +1,195 @@
+#include <ESP8266WiFi.h>
+
+#include "sim.h"
+
+ESP8266WiFiClass WiFi;
+
+// a passive scan listens this long on every channel
+constexpr uint32_t SCAN_DWELL_US = 120000;
+constexpr uint8_t SCAN_CHANNELS = 13;
+constexpr uint8_t SIM_MAX_RESULTS = 16;
+
+// beacons/data frames the sniffer sees per AP and radio tick
+constexpr uint8_t FRAMES_PER_AP = 3;
+
+struct SimAccessPoint {
+    const char *ssid;
+    uint8_t bssid[6];
+    uint8_t channel;
+    int8_t rssi;
+    AUTH_MODE auth;
+    bool hidden;
+};
+
+// a typical block of flats, with a hidden network and an over-long name
+static const SimAccessPoint accessPoints[] = {
+    {"dom_kajdanka", {0x10, 0, 0, 0, 0, 1}, 1, -42, AUTH_WPA2_PSK, false},
+    {"UPC1234567", {0x10, 0, 0, 0, 0, 2}, 6, -67, AUTH_WPA_WPA2_PSK, false},
+    {"kawiarnia-free", {0x10, 0, 0, 0, 0, 3}, 11, -71, AUTH_OPEN, false},
+    {"", {0x10, 0, 0, 0, 0, 4}, 6, -80, AUTH_WPA2_PSK, true},
+    {"bardzo_dluga_nazwa_sieci_wifi_32", {0x10, 0, 0, 0, 0, 5}, 3, -55,
+     AUTH_WPA2_PSK, false},
+    {"Orange_Swiatlowod_ABCD", {0x10, 0, 0, 0, 0, 6}, 1, -88, AUTH_WPA2_PSK,
+     false},
+    {"TP-Link_5E21", {0x10, 0, 0, 0, 0, 7}, 13, -60, AUTH_WEP, false},
+    {"printer", {0x10, 0, 0, 0, 0, 8}, 11, -49, AUTH_OPEN, false},
+};
+
+struct ScanState {
+    int8_t status; // result count, WIFI_SCAN_RUNNING or WIFI_SCAN_FAILED
+    uint64_t doneAt;
+    uint8_t channel; // 0 = all channels
+    bool showHidden;
+    bss_info results[SIM_MAX_RESULTS];
+};
+
+static ScanState scan = {WIFI_SCAN_FAILED, 0, 0, false, {}};
+
+static wifi_promiscuous_cb_t promiscuousCb = nullptr;
+static bool promiscuous = false;
+static uint8_t radioChannel = 1;
+
+static void finishScan() {
+    uint8_t count = 0;
+
+    for (const SimAccessPoint &ap : accessPoints) {
+        if (scan.channel && ap.channel != scan.channel) {
+            continue;
+        }
+        if (ap.hidden && !scan.showHidden) {
+            continue;
+        }
+        if (count == SIM_MAX_RESULTS) {
+            break;
+        }
+
+        bss_info &info = scan.results[count++];
+        info = {};
+        memcpy(info.bssid, ap.bssid, sizeof(info.bssid));
+        info.ssid_len = strlen(ap.ssid);
+        memcpy(info.ssid, ap.ssid, info.ssid_len);
+        info.channel = ap.channel;
+        info.rssi = ap.rssi + rand() % 7 - 3; // a bit of fading
+        info.authmode = ap.auth;
+        info.is_hidden = ap.hidden;
+    }
+
+    scan.status = count;
+}
+
+int8_t ESP8266WiFiClass::scanNetworks(bool async, bool show_hidden,
+                                      uint8 channel, uint8 *ssid) {
+    (void)ssid;
+
+    scan.status = WIFI_SCAN_RUNNING;
+    scan.channel = channel;
+    scan.showHidden = show_hidden;
+    scan.doneAt = simNow() + SCAN_DWELL_US * (channel ? 1 : SCAN_CHANNELS);
+
+    if (!async) {
+        simAdvance(scan.doneAt - simNow());
+        finishScan();
+    }
+    return scan.status;
+}
+
+int8_t ESP8266WiFiClass::scanComplete() {
+    if (scan.status == WIFI_SCAN_RUNNING && simNow() >= scan.doneAt) {
+        finishScan();
+    }
+    return scan.status;
+}
+
+void ESP8266WiFiClass::scanDelete() { scan.status = WIFI_SCAN_FAILED; }
+
+const bss_info *ESP8266WiFiClass::getScanInfoByIndex(int i) {
+    if (i < 0 || i >= scan.status) {
+        return nullptr;
+    }
+    return &scan.results[i];
+}
+
+String ESP8266WiFiClass::SSID(uint8_t i) {
+    const bss_info *info = getScanInfoByIndex(i);
+    if (!info) {
+        return String();
+    }
+    return String(std::string((const char *)info->ssid, info->ssid_len));
+}
+
+uint8_t ESP8266WiFiClass::encryptionType(uint8_t i) {
+    const bss_info *info = getScanInfoByIndex(i);
+    if (!info) {
+        return 255;
+    }
+
+    switch (info->authmode) {
+    case AUTH_OPEN:
+        return ENC_TYPE_NONE;
+    case AUTH_WEP:
+        return ENC_TYPE_WEP;
+    case AUTH_WPA_PSK:
+        return ENC_TYPE_TKIP;
+    case AUTH_WPA2_PSK:
+        return ENC_TYPE_CCMP;
+    default:
+        return ENC_TYPE_AUTO;
+    }
+}
+
+int32_t ESP8266WiFiClass::RSSI(uint8_t i) {
+    const bss_info *info = getScanInfoByIndex(i);
+    return info ? info->rssi : 0;
+}
+
+uint8_t *ESP8266WiFiClass::BSSID(uint8_t i) {
+    const bss_info *info = getScanInfoByIndex(i);
+    return info ? (uint8_t *)info->bssid : nullptr;
+}
+
+int32_t ESP8266WiFiClass::channel(uint8_t i) {
+    const bss_info *info = getScanInfoByIndex(i);
+    return info ? info->channel : 0;
+}
+
+bool ESP8266WiFiClass::isHidden(uint8_t i) {
+    const bss_info *info = getScanInfoByIndex(i);
+    return info ? info->is_hidden : false;
+}
+
+void wifi_set_promiscuous_rx_cb(wifi_promiscuous_cb_t cb) {
+    promiscuousCb = cb;
+}
+
+void wifi_promiscuous_enable(uint8 enable) { promiscuous = enable; }
+
+bool wifi_set_channel(uint8 channel) {
+    radioChannel = channel;
+    return true;
+}
+
+uint8 wifi_get_channel(void) { return radioChannel; }
+
+/**
+ * @brief Feeds the promiscuous callback the traffic of the current channel
+ *
+ * Called by the driver after every loop() pass. The frames only carry an
+ * RSSI byte (first byte of the SDK's rx_control header) and a length.
+ */
+void simRadioTick() {
+    if (!promiscuous || !promiscuousCb) {
+        return;
+    }
+
+    static uint8_t frame[128];
+    for (const SimAccessPoint &ap : accessPoints) {
+        if (ap.channel != radioChannel) {
+            continue;
+        }
+        for (uint8_t i = 0; i < FRAMES_PER_AP; i++) {
+            memset(frame, 0, sizeof(frame));
+            frame[0] = (uint8_t)(ap.rssi + rand() % 7 - 3);
+            promiscuousCb(frame, 60 + rand() % 60);
+        }
+    }
+}
@@ -0,0 +1,175 @@
+#include "bench.h"
+
+#if KVDAN_BENCH
+
+#include "ui/menu.h"
+#include "ui/text.h"
+#include "ui/ui.h"
+
+constexpr uint16_t BENCH_RUNS = 50;
+
+#ifdef ESP8266
+const char benchTarget[] = "esp8266";
+#else
+const char benchTarget[] = "native";
+#endif
+
+typedef void (*BenchDrawFn)(uint16_t run);
+
+struct BenchTotals {
+    uint32_t drawCycles;
+    uint32_t flushCycles;
+    uint32_t flushBytes;
+};
+
+static uint32_t cyclesToUs(uint32_t cycles) {
+    return cycles / ESP.getCpuFreqMHz();
+}
+
+static void printPrimitive(const char *name, const BenchTotals &totals) {
+    uint32_t draw = totals.drawCycles / BENCH_RUNS;
+    uint32_t flush = totals.flushCycles / BENCH_RUNS;
+
+    Serial.printf("{\"bench\":\"%s\",\"target\":\"%s\",\"runs\":%u,"
+                  "\"draw_cycles\":%lu,\"draw_us\":%lu,"
+                  "\"flush_cycles\":%lu,\"flush_us\":%lu,"
+                  "\"flush_bytes\":%lu}\n",
+                  name, benchTarget, BENCH_RUNS, (unsigned long)draw,
+                  (unsigned long)cyclesToUs(draw), (unsigned long)flush,
+                  (unsigned long)cyclesToUs(flush),
+                  (unsigned long)(totals.flushBytes / BENCH_RUNS));
+}
+
+/**
+ * @brief Times one primitive on its own, averaged over BENCH_RUNS
+ *
+ * Every run starts from a blank panel, so the flush sends exactly the
+ * pixels the primitive set and the numbers do not depend on what ran
+ * before it.
+ */
+static void benchPrimitive(const char *name, BenchDrawFn draw) {
+    BenchTotals totals = {0, 0, 0};
+
+    for (uint16_t run = 0; run < BENCH_RUNS; run++) {
+        display.clearDisplay();
+        display.display();
+
+        uint32_t start = ESP.getCycleCount();
+        draw(run);
+        uint32_t drawn = ESP.getCycleCount();
+        display.display();
+        uint32_t flushed = ESP.getCycleCount();
+
+        totals.drawCycles += drawn - start;
+        totals.flushCycles += flushed - drawn;
+        totals.flushBytes += display.lastFlush().bytes;
+        yield();
+    }
+
+    printPrimitive(name, totals);
+}
+
+static void benchHeader(uint16_t run) {
+    uint8_t items = menuLevelSize();
+    drawHeader("kajdanecek :3", run % items + 1, items);
+}
+
+static void benchSelectionBox(uint16_t run) {
+    (void)run;
+    drawSelectionBox(30, 30, 68, 12);
+}
+
+static void benchNavigationDots(uint16_t run) {
+    (void)run;
+    drawNavigationDots();
+}
+
+static void benchDecorativeLine(uint16_t run) {
+    (void)run;
+    drawDecorativeLine();
+}
+
+// the centering done for every menu item label
+static void benchCenterText(uint16_t run) {
+    const __FlashStringHelper *text = menuItemLabel(run % menuLevelSize());
+
+    display.setTextSize(1);
+    display.setCursor((SCREEN_WIDTH - textWidth(text)) / 2, 32);
+    display.print(text);
+}
+
+/**
+ * @brief Times complete menu slides, one per menu item
+ *
+ * Only the animation ticks themselves are counted, not the hold time
+ * between frames, so the result is the CPU + bus cost of a transition.
+ */
+static void benchMenuTransition() {
+    int runs = menuLevelSize();
+    uint32_t cycles = 0;
+    uint32_t frames = 0;
+    uint32_t bytes = 0;
+
+    for (int run = 0; run < runs; run++) {
+        unsigned long flushes = display.flushes();
+        uint32_t start = ESP.getCycleCount();
+        menuStep(1); // draws the first frame right away
+
+        while (true) {
+            cycles += ESP.getCycleCount() - start;
+            if (display.flushes() != flushes) {
+                flushes = display.flushes();
+                frames++;
+                bytes += display.lastFlush().bytes;
+            }
+            if (!animationRunning() && !display.flushPending()) {
+                break;
+            }
+            delay(1);
+            start = ESP.getCycleCount();
+            animationTick();
+            display.flushTick();
+        }
+    }
+
+    uint32_t perFrame = frames ? cycles / frames : 0;
+    Serial.printf("{\"bench\":\"menuTransition\",\"target\":\"%s\","
+                  "\"runs\":%d,\"frames\":%lu,\"frame_cycles\":%lu,"
+                  "\"frame_us\":%lu,\"transition_us\":%lu,"
+                  "\"flush_bytes\":%lu}\n",
+                  benchTarget, runs, (unsigned long)frames,
+                  (unsigned long)perFrame, (unsigned long)cyclesToUs(perFrame),
+                  (unsigned long)cyclesToUs(cycles / runs),
+                  (unsigned long)(frames ? bytes / frames : 0));
+}
+
+// raw panel bandwidth with whole-page transactions
+static void benchBus() {
+    uint32_t rate = display.busSelfTest();
+    const OledBusStats &bus = oledBusStats();
+
+    Serial.printf("{\"bench\":\"i2c\",\"target\":\"%s\",\"clock\":%lu,"
+                  "\"bytes_per_s\":%lu,\"errors\":%u}\n",
+                  benchTarget, (unsigned long)bus.clock, (unsigned long)rate,
+                  bus.errors);
+}
+
+/**
+ * @brief Runs every benchmark and prints one JSON line per result
+ *
+ * Leaves the screen blank, the caller draws whatever comes next.
+ */
+void runBenchmarks() {
+    benchPrimitive("drawHeader", benchHeader);
+    benchPrimitive("drawSelectionBox", benchSelectionBox);
+    benchPrimitive("drawNavigationDots", benchNavigationDots);
+    benchPrimitive("drawDecorativeLine", benchDecorativeLine);
+    benchPrimitive("centerText", benchCenterText);
+    benchMenuTransition();
+    benchBus();
+
+    display.clearDisplay();
+    display.display();
+}
+
+#endif
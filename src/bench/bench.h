@@ -0,0 +1,20 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "config.h"
+
+// Draw and flush cost of the UI primitives, printed as one JSON object per
+// line so runs can be diffed or fed to a script. Only compiled in with
+// KVDAN_BENCH; runs on the device and in the native build alike.
+
+#if KVDAN_BENCH
+
+void runBenchmarks();
+
+#else
+
+inline void runBenchmarks() {}
+
+#endif
+
+#endif
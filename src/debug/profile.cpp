@@ -0,0 +1,246 @@
+#include "profile.h"
+
+#if KVDAN_DEBUG
+
+#include "ui/ui.h"
+
+constexpr unsigned long OVERLAY_CHORD = 1000;  // ms UP+DOWN held to toggle
+constexpr unsigned long OVERLAY_REFRESH = 500; // ms between overlay updates
+constexpr uint8_t OVERLAY_FIRST_PAGE = 5;      // bottom three text lines
+constexpr uint8_t OVERLAY_PAGES = OLED_PAGES - OVERLAY_FIRST_PAGE;
+
+const char *const phaseNames[] = {"render", "flush", "loop"};
+const char phaseTags[] = {'R', 'F', 'L'};
+
+struct ProfileWindow {
+    PhaseStats phases[PROFILE_PHASES];
+    uint32_t flushBytes;
+};
+
+static uint32_t startCycles[PROFILE_PHASES];
+static bool running[PROFILE_PHASES];
+
+static ProfileWindow current;
+static ProfileWindow last;
+static bool started = false;
+static unsigned long windowStart = 0;
+
+static bool overlay = false;
+static bool overlayShown = false;
+static unsigned long overlayTime = 0;
+static unsigned long chordStart = 0;
+static bool chordHandled = false;
+static uint8_t overlaySaved[SCREEN_WIDTH * OVERLAY_PAGES];
+
+static void resetWindow(ProfileWindow &window) {
+    window = {};
+    for (PhaseStats &stats : window.phases) {
+        stats.minUs = UINT32_MAX;
+    }
+}
+
+// bucket b holds times in [2^(b-1), 2^b) us, the last one everything above
+static uint8_t histogramBucket(uint32_t us) {
+    uint8_t bucket = 0;
+    while (us && bucket < PROFILE_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+static uint32_t averageUs(const PhaseStats &stats) {
+    return stats.count ? stats.totalUs / stats.count : 0;
+}
+
+/**
+ * @brief Starts timing a phase, restarts it if it was already running
+ */
+void profileBegin(ProfilePhase phase) {
+    startCycles[phase] = ESP.getCycleCount();
+    running[phase] = true;
+}
+
+/**
+ * @brief Stops timing a phase and adds the sample to the current window
+ *
+ * Does nothing when the phase was not started, so e.g. a flush without a
+ * preceding clearDisplay() does not produce a bogus render sample.
+ */
+void profileEnd(ProfilePhase phase) {
+    if (!running[phase]) {
+        return;
+    }
+    running[phase] = false;
+
+    uint32_t cycles = ESP.getCycleCount() - startCycles[phase];
+    uint32_t us = cycles / ESP.getCpuFreqMHz();
+
+    PhaseStats &stats = current.phases[phase];
+    if (us < stats.minUs) {
+        stats.minUs = us;
+    }
+    if (us > stats.maxUs) {
+        stats.maxUs = us;
+    }
+    stats.totalUs += us;
+    if (stats.count < UINT16_MAX) {
+        stats.count++;
+    }
+    uint16_t &bucket = stats.histogram[histogramBucket(us)];
+    if (bucket < UINT16_MAX) {
+        bucket++;
+    }
+}
+
+/**
+ * @brief Counts display data bytes sent by a flush, for the I2C throughput
+ */
+void profileFlushBytes(uint16_t bytes) { current.flushBytes += bytes; }
+
+static void printWindow() {
+    for (uint8_t i = 0; i < PROFILE_PHASES; i++) {
+        const PhaseStats &stats = last.phases[i];
+        Serial.printf("prof %-6s n=%u", phaseNames[i], stats.count);
+        if (stats.count) {
+            Serial.printf(" min=%lu avg=%lu max=%lu us hist=",
+                          (unsigned long)stats.minUs,
+                          (unsigned long)averageUs(stats),
+                          (unsigned long)stats.maxUs);
+            for (uint8_t b = 0; b < PROFILE_BUCKETS; b++) {
+                Serial.printf(b ? ",%u" : "%u", stats.histogram[b]);
+            }
+        }
+        Serial.println();
+    }
+
+    uint32_t flushUs = last.phases[PROFILE_FLUSH].totalUs;
+    if (flushUs) {
+        // bytes per ms is kB/s
+        Serial.printf("prof i2c    %lu B in %lu us, %lu kB/s\n",
+                      (unsigned long)last.flushBytes, (unsigned long)flushUs,
+                      (unsigned long)(last.flushBytes * 1000ULL / flushUs));
+    }
+}
+
+// "  1.2" style milliseconds, good up to 999.9
+static void formatMs(char *out, size_t size, uint32_t us) {
+    snprintf(out, size, "%3lu.%lu", (unsigned long)(us / 1000),
+             (unsigned long)(us / 100 % 10));
+}
+
+/**
+ * @brief Draws avg/max ms per phase over the bottom of the frame
+ *
+ * Called by the display right before a flush. The pixels underneath are
+ * saved and put back by profileOverlayRestore() afterwards, so the overlay
+ * never ends up in what the screens draw on top of.
+ *
+ * @return true when the overlay is on and was drawn
+ */
+bool profileOverlayDraw() {
+    if (!overlay) {
+        return false;
+    }
+
+    uint8_t *area = display.getBuffer() + OVERLAY_FIRST_PAGE * SCREEN_WIDTH;
+    memcpy(overlaySaved, area, sizeof(overlaySaved));
+    overlayShown = true;
+
+    display.fillRect(0, OVERLAY_FIRST_PAGE * 8, SCREEN_WIDTH,
+                     OVERLAY_PAGES * 8, SH110X_BLACK);
+    display.setTextSize(1);
+
+    unsigned long windowSeconds = PROFILE_WINDOW / 1000;
+    uint32_t flushUs = last.phases[PROFILE_FLUSH].totalUs;
+
+    for (uint8_t i = 0; i < PROFILE_PHASES; i++) {
+        const PhaseStats &stats = last.phases[i];
+        char avg[12];
+        char peak[12];
+        formatMs(avg, sizeof(avg), averageUs(stats));
+        formatMs(peak, sizeof(peak), stats.maxUs);
+
+        display.setCursor(0, (OVERLAY_FIRST_PAGE + i) * 8);
+        display.printf("%c%s/%s", phaseTags[i], avg, peak);
+
+        if (i == PROFILE_RENDER) {
+            display.printf(" %ufps", (unsigned)(stats.count / windowSeconds));
+        } else if (i == PROFILE_FLUSH && flushUs) {
+            display.printf(" %lukB/s",
+                           (unsigned long)(last.flushBytes * 1000ULL /
+                                           flushUs));
+        }
+    }
+    return true;
+}
+
+void profileOverlayRestore() {
+    if (!overlayShown) {
+        return;
+    }
+
+    uint8_t *area = display.getBuffer() + OVERLAY_FIRST_PAGE * SCREEN_WIDTH;
+    memcpy(area, overlaySaved, sizeof(overlaySaved));
+    overlayShown = false;
+}
+
+static void toggleOverlay() {
+    overlay = !overlay;
+    // show or remove it right away, screens only flush when they change
+    display.present();
+    overlayTime = millis();
+}
+
+// UP+DOWN held together; the first of the two still acts as a normal press
+static bool overlayChord() {
+    if (digitalRead(BTN_UP) != LOW || digitalRead(BTN_DOWN) != LOW) {
+        chordStart = 0;
+        chordHandled = false;
+        return false;
+    }
+    if (!chordStart) {
+        chordStart = millis();
+    }
+    if (chordHandled || millis() - chordStart < OVERLAY_CHORD) {
+        return false;
+    }
+    chordHandled = true;
+    return true;
+}
+
+/**
+ * @brief Closes finished windows and handles the overlay, once per loop()
+ */
+void profileTick() {
+    unsigned long now = millis();
+
+    if (!started) {
+        resetWindow(current);
+        resetWindow(last);
+        windowStart = now;
+        started = true;
+    }
+
+    if (now - windowStart >= PROFILE_WINDOW) {
+        last = current;
+        resetWindow(current);
+        windowStart = now;
+        printWindow();
+    }
+
+    bool toggle = overlayChord();
+    while (Serial.available()) {
+        if (Serial.read() == 'o') {
+            toggle = !toggle;
+        }
+    }
+    if (toggle) {
+        toggleOverlay();
+    } else if (overlay && now - overlayTime >= OVERLAY_REFRESH) {
+        display.present();
+        overlayTime = now;
+    }
+}
+
+#endif
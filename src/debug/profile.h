@@ -0,0 +1,63 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <Arduino.h>
+
+#include "config.h"
+
+// Frame-time profiler, only compiled in with KVDAN_DEBUG. Each phase is
+// timed with the CPU cycle counter; the stats of every window go out over
+// Serial and onto an overlay that is toggled by holding UP+DOWN (or by
+// sending 'o' over Serial). Without KVDAN_DEBUG all calls are empty inlines.
+
+enum ProfilePhase : uint8_t {
+    PROFILE_RENDER, // clearDisplay() up to present()
+    PROFILE_FLUSH,  // one flushTick(), mostly I2C
+    PROFILE_LOOP,   // one loop() pass without its idle delay
+    PROFILE_PHASES
+};
+
+constexpr uint8_t PROFILE_BUCKETS = 16;         // log2 of the time in us
+constexpr unsigned long PROFILE_WINDOW = 2000; // ms per reported window
+
+struct PhaseStats {
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint32_t totalUs;
+    uint16_t count;
+    uint16_t histogram[PROFILE_BUCKETS]; // bucket b: [2^(b-1), 2^b) us
+};
+
+#if KVDAN_DEBUG
+
+void profileBegin(ProfilePhase phase);
+void profileEnd(ProfilePhase phase);
+void profileFlushBytes(uint16_t bytes);
+void profileTick();
+bool profileOverlayDraw();
+void profileOverlayRestore();
+
+#else
+
+inline void profileBegin(ProfilePhase) {}
+inline void profileEnd(ProfilePhase) {}
+inline void profileFlushBytes(uint16_t) {}
+inline void profileTick() {}
+inline bool profileOverlayDraw() { return false; }
+inline void profileOverlayRestore() {}
+
+#endif
+
+// times the enclosing block
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfilePhase phase) : phase(phase) {
+        profileBegin(phase);
+    }
+    ~ProfileScope() { profileEnd(phase); }
+
+private:
+    ProfilePhase phase;
+};
+
+#endif
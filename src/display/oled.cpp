@@ -0,0 +1,304 @@
+#include "oled.h"
+#include "debug/profile.h"
+
+// an extra segment costs a transaction of its own with a 7 byte header,
+// so short runs of unchanged columns are cheaper to resend than to skip
+constexpr uint8_t SEGMENT_MERGE_GAP = 8;
+
+// Copies the 64 rows of `from` into `to` so that row y of `to` is row
+// (y + first) % 64 of `from`. When first is not a multiple of 8 each byte is
+// put together from two source pages.
+static void rotateRows(uint8_t *to, const uint8_t *from, uint8_t first) {
+    if (first == 0) {
+        memcpy(to, from, SCREEN_WIDTH * OLED_PAGES);
+        return;
+    }
+
+    for (uint8_t page = 0; page < OLED_PAGES; page++) {
+        uint8_t row = (page * 8 + first) % SCREEN_HEIGHT;
+        const uint8_t *upper = from + (row / 8) * SCREEN_WIDTH;
+        uint8_t *out = to + page * SCREEN_WIDTH;
+        uint8_t shift = row % 8;
+
+        if (shift == 0) {
+            memcpy(out, upper, SCREEN_WIDTH);
+            continue;
+        }
+
+        const uint8_t *lower =
+            from + ((row / 8 + 1) % OLED_PAGES) * SCREEN_WIDTH;
+        for (uint8_t x = 0; x < SCREEN_WIDTH; x++) {
+            out[x] = (upper[x] >> shift) | (lower[x] << (8 - shift));
+        }
+    }
+}
+
+OledDisplay::OledDisplay(uint16_t w, uint16_t h, TwoWire *twi, int8_t rst_pin)
+    : Adafruit_SH1106G(w, h, twi, rst_pin) {}
+
+bool OledDisplay::begin(uint8_t i2caddr, bool reset) {
+    // panel RAM content is unknown after init
+    invalidate();
+    if (!Adafruit_SH1106G::begin(i2caddr, reset)) {
+        return false;
+    }
+    oledBusBegin(SDA_PIN, SCL_PIN, i2caddr);
+    panelStartLine = 0; // the init sequence sets it
+    return true;
+}
+
+/**
+ * @brief Makes the next flush resend whole pages
+ *
+ * Needed whenever the panel RAM may no longer match the shadow copy,
+ * e.g. after a reset or after talking to the controller directly.
+ */
+void OledDisplay::invalidate() {
+    stalePages = 0xFF;
+    nextColumn = 0;
+    panelStartLine = OLED_START_LINE_UNKNOWN;
+}
+
+/**
+ * @brief Sets the display start line the next present() lays its frame
+ * out for
+ *
+ * Drawing doesn't change, the buffer always holds screen rows. Scrolling
+ * content by moving the start line along with it keeps that content at the
+ * same RAM lines, so flushing only sends what came into view and whatever
+ * is meant to stay put on the screen. Any other frame costs what it would
+ * at start line 0.
+ *
+ * @param line 0..63, the RAM line shown on the top screen row
+ */
+void OledDisplay::setStartLine(uint8_t line) {
+    startLine = line % SCREEN_HEIGHT;
+}
+
+/**
+ * @brief Puts the last presented frame back into the frame buffer, laid out
+ * for the start line set since
+ *
+ * Content that moved along with the start line lands where it belongs on
+ * the screen, so a scrolled frame only has to draw what came into view
+ * instead of starting from clearDisplay().
+ *
+ * @return false when that frame can't be told apart from the profiler
+ *         overlay drawn into it, the buffer is then left alone
+ */
+bool OledDisplay::recallFrame() {
+    if (frameOverlay) {
+        return false;
+    }
+    rotateRows(buffer, front, startLine);
+    return true;
+}
+
+/**
+ * @brief Turns the panel off (0xAE) or back on (0xAF)
+ *
+ * The controller keeps its RAM while off, so the same frame comes back
+ * without a redraw.
+ */
+void OledDisplay::setPower(bool on) {
+    oled_command(on ? SH110X_DISPLAYON : SH110X_DISPLAYOFF);
+}
+
+/**
+ * @brief Measures the bus by rewriting the presented frame, see
+ * oledBusSelfTest()
+ *
+ * @return display data bytes per second, 0 when the panel stopped ACKing
+ */
+uint32_t OledDisplay::busSelfTest() {
+    uint32_t rate = oledBusSelfTest(front, _page_start_offset);
+
+    // every page was written whole, or may be half written
+    memcpy(shadow, front, sizeof(shadow));
+    stalePages = rate ? 0 : 0xFF;
+    return rate;
+}
+
+/**
+ * @brief Clears the frame buffer, which is where a new frame starts
+ *
+ * Only here so the profiler can time rendering from this point on.
+ */
+void OledDisplay::clearDisplay() {
+    profileBegin(PROFILE_RENDER);
+    Adafruit_SH1106G::clearDisplay();
+}
+
+/**
+ * @brief Pushes the changed parts of the frame buffer to the panel and
+ * waits for it
+ *
+ * Hides Adafruit_SH110X::display(). Kept for the few places that need the
+ * panel current before going on (benchmarks, setup), frames drawn from
+ * loop() use present().
+ */
+void OledDisplay::display() {
+    present();
+    flushTick(UINT16_MAX);
+}
+
+/**
+ * @brief Hands the frame buffer over to flushTick(), drawing the next frame
+ * can start right away
+ *
+ * A frame still being sent is replaced: what it already sent stays on the
+ * panel and every page gets compared against the new one. Flushing carries
+ * on from the page it had reached, so frames coming faster than the bus
+ * takes them still reach the bottom of the screen.
+ *
+ * The base class dirty window is not used: it grows to the full screen on
+ * every clearDisplay(), which is exactly the common case.
+ */
+void OledDisplay::present() {
+    profileEnd(PROFILE_RENDER);
+    frameOverlay = profileOverlayDraw();
+    frameStartLine = startLine;
+    mapToRam();
+    profileOverlayRestore();
+    presentCount++;
+
+    if (pagesLeft == 0) {
+        sending = {0, 0};
+    }
+    pagesLeft = OLED_PAGES;
+    nextColumn = 0;
+
+    // keep the base class window consistent with "nothing pending"
+    window_x1 = 1024;
+    window_y1 = 1024;
+    window_x2 = -1;
+    window_y2 = -1;
+}
+
+/**
+ * @brief Sends the next part of the presented frame, call once per loop()
+ * pass
+ *
+ * Pages are compared against the shadow copy of the panel RAM, only the
+ * changed segments go out. Stops once `budget` bytes were sent. A segment
+ * is never split, so a tick can overshoot by up to one page row.
+ *
+ * @return true when the panel shows the presented frame
+ * @note An unchanged frame costs one memcmp-style pass and no I2C traffic
+ */
+bool OledDisplay::flushTick(uint16_t budget) {
+    if (pagesLeft == 0) {
+        return true;
+    }
+    if (!oledBusReady()) {
+        return false;
+    }
+
+    profileBegin(PROFILE_FLUSH);
+    yield();
+
+    // first, so the rows already in RAM show in the right place right away
+    if (panelStartLine != frameStartLine) {
+        if (!oledBusCommand(SH110X_SETSTARTLINE | frameStartLine)) {
+            profileEnd(PROFILE_FLUSH);
+            return false;
+        }
+        panelStartLine = frameStartLine;
+    }
+
+    uint16_t bytes = 0;
+    while (pagesLeft > 0 && bytes < budget) {
+        bytes += flushPage(nextPage, nextColumn, budget - bytes);
+        if (nextColumn < SCREEN_WIDTH) {
+            break; // out of budget or a failed write halfway through
+        }
+        stalePages &= ~(1 << nextPage);
+        nextPage = (nextPage + 1) % OLED_PAGES;
+        nextColumn = 0;
+        pagesLeft--;
+    }
+
+    if (pagesLeft == 0) {
+        stats = sending;
+        flushCount++;
+    }
+
+    profileEnd(PROFILE_FLUSH);
+    profileFlushBytes(bytes);
+    return pagesLeft == 0;
+}
+
+// Lays the frame buffer out in front for frameStartLine: RAM page p holds
+// screen rows 8p - S .. 8p - S + 7, wrapping around.
+void OledDisplay::mapToRam() {
+    uint8_t first = (SCREEN_HEIGHT - frameStartLine) % SCREEN_HEIGHT;
+    rotateRows(front, buffer, first);
+}
+
+// Sends what differs in `page` from column x on, x is left at SCREEN_WIDTH
+// once the page is done. Changed columns are grouped into segments, runs
+// closer than SEGMENT_MERGE_GAP are merged. A failed write leaves x where
+// it was and the page stale, the next tick resends it. Returns the bytes
+// sent.
+uint16_t OledDisplay::flushPage(uint8_t page, uint8_t &x, uint16_t budget) {
+    const uint8_t *row = front + page * SCREEN_WIDTH;
+    uint8_t *sent = shadow + page * SCREEN_WIDTH;
+    uint16_t bytes = 0;
+
+    if (stalePages & (1 << page)) {
+        bytes = SCREEN_WIDTH - x;
+        if (!sendSegment(page, x, SCREEN_WIDTH - 1)) {
+            return 0;
+        }
+        memcpy(sent + x, row + x, bytes);
+        x = SCREEN_WIDTH;
+        return bytes;
+    }
+
+    while (x < SCREEN_WIDTH && bytes < budget) {
+        // find the next changed column
+        while (x < SCREEN_WIDTH && row[x] == sent[x]) {
+            x++;
+        }
+        if (x == SCREEN_WIDTH) {
+            break;
+        }
+
+        // extend the segment until a long enough unchanged run
+        int start = x;
+        int end = x;
+        int gap = 0;
+        for (int i = x + 1; i < SCREEN_WIDTH && gap <= SEGMENT_MERGE_GAP;
+             i++) {
+            if (row[i] != sent[i]) {
+                end = i;
+                gap = 0;
+            } else {
+                gap++;
+            }
+        }
+
+        if (!sendSegment(page, start, end)) {
+            x = start;
+            stalePages |= 1 << page;
+            break;
+        }
+        memcpy(sent + start, row + start, end - start + 1);
+        bytes += end - start + 1;
+        x = end + 1;
+    }
+    return bytes;
+}
+
+bool OledDisplay::sendSegment(uint8_t page, uint8_t x0, uint8_t x1) {
+    const uint8_t *ptr = front + page * SCREEN_WIDTH + x0;
+    uint8_t length = x1 - x0 + 1;
+
+    if (!oledBusWrite(page, x0 + _page_start_offset, ptr, length)) {
+        return false;
+    }
+
+    sending.bytes += length;
+    sending.segments++;
+    return true;
+}
@@ -0,0 +1,76 @@
+#ifndef OLED_H
+#define OLED_H
+
+#include <Adafruit_SH110X.h>
+
+#include "config.h"
+#include "oled_bus.h"
+
+constexpr uint8_t OLED_PAGES = SCREEN_HEIGHT / 8;
+
+// bytes sent per flushTick(), about 6 ms of bus time at 400 kHz (half that
+// at 800 kHz, which needs a 160 MHz CPU)
+constexpr uint16_t FLUSH_CHUNK = 256;
+
+constexpr uint8_t OLED_START_LINE_UNKNOWN = 0xFF;
+
+// what flushing the last completed frame actually put on the bus
+struct FlushStats {
+    uint16_t bytes;   // display data bytes
+    uint8_t segments; // page/column ranges addressed
+};
+
+// SH1106 driver that keeps a copy of what the panel currently shows and only
+// sends the column ranges of each page that differ from it.
+//
+// Double buffered: drawing goes to the Adafruit buffer, present() copies it
+// to a front buffer and flushTick() streams that to the panel a chunk at a
+// time from loop(), so the next frame is drawn between chunks instead of
+// after the whole transfer. display() still flushes the frame in one go.
+//
+// The front buffer and the shadow hold panel RAM, not screen rows. With a
+// start line S set, screen row y is RAM line (y + S) % 64, so content that
+// moves up by as many rows as S grows by stays where it is in RAM and only
+// the rows that changed on screen are sent.
+class OledDisplay : public Adafruit_SH1106G {
+public:
+    OledDisplay(uint16_t w, uint16_t h, TwoWire *twi, int8_t rst_pin);
+
+    bool begin(uint8_t i2caddr, bool reset = true);
+    void clearDisplay();
+    void display();
+    void present();
+    bool flushTick(uint16_t budget = FLUSH_CHUNK);
+    bool flushPending() const { return pagesLeft > 0 && oledBusReady(); }
+    void invalidate();
+    void setStartLine(uint8_t line);
+    bool recallFrame();
+    void setPower(bool on);
+    uint32_t busSelfTest();
+
+    const FlushStats &lastFlush() const { return stats; }
+    unsigned long flushes() const { return flushCount; } // since boot
+    unsigned long presents() const { return presentCount; } // since boot
+
+private:
+    uint16_t flushPage(uint8_t page, uint8_t &x, uint16_t budget);
+    bool sendSegment(uint8_t page, uint8_t x0, uint8_t x1);
+    void mapToRam();
+
+    uint8_t front[SCREEN_WIDTH * OLED_PAGES];  // the frame being sent
+    uint8_t shadow[SCREEN_WIDTH * OLED_PAGES]; // what the panel RAM holds
+    uint8_t stalePages = 0xFF;  // bit per page the shadow can't vouch for
+    uint8_t pagesLeft = 0;      // of the presented frame, still to compare
+    uint8_t nextPage = 0;       // flushing goes round the pages
+    uint8_t nextColumn = 0;     // where nextPage was left off
+    uint8_t startLine = 0;      // for the next present()
+    uint8_t frameStartLine = 0; // what front is laid out for
+    uint8_t panelStartLine = OLED_START_LINE_UNKNOWN; // what the panel uses
+    bool frameOverlay = false; // the profiler drew into front
+    FlushStats sending = {0, 0};
+    FlushStats stats = {0, 0};
+    unsigned long flushCount = 0;
+    unsigned long presentCount = 0;
+};
+
+#endif
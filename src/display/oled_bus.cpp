@@ -0,0 +1,196 @@
+#include <Arduino.h>
+#include <twi.h>
+
+#include "config.h"
+#include "oled_bus.h"
+
+// Fastest first. The SH1106 datasheet stops at 400 kHz but most modules
+// take more; a clock the panel can't follow shows up as missing ACKs. The
+// core's twi driver can't bit-bang more than 400 kHz at 80 MHz and quietly
+// caps the clock there, so 800 kHz is only tried on a 160 MHz CPU.
+#if F_CPU >= 160000000L
+static const uint32_t clockLadder[] = {800000, 400000, 100000};
+#else
+static const uint32_t clockLadder[] = {400000, 100000};
+#endif
+constexpr uint8_t CLOCK_RUNGS = sizeof(clockLadder) / sizeof(clockLadder[0]);
+
+constexpr uint8_t CONTROL_COMMAND = 0x80; // Co set: one command byte follows
+constexpr uint8_t CONTROL_DATA = 0x40;    // Co clear: data up to the stop
+constexpr uint8_t SEGMENT_HEADER = 7;
+
+static uint8_t sdaPin = SDA_PIN;
+static uint8_t sclPin = SCL_PIN;
+static uint8_t busAddress = SCREEN_ADDRESS;
+static uint8_t rung = 0;
+static uint8_t strikes = 0;
+static unsigned long failedAt = 0;
+static bool backingOff = false;
+static OledBusStats stats = {0, 0, 0};
+
+// one page segment, header and data sent as a single transaction
+static uint8_t tx[SEGMENT_HEADER + SCREEN_WIDTH];
+
+static void setRung(uint8_t index) {
+    rung = index;
+    stats.clock = clockLadder[rung];
+    twi_setClock(stats.clock);
+}
+
+static bool probe() {
+    uint8_t nop[] = {0x00, OLED_NOP};
+    for (uint8_t i = 0; i < OLED_BUS_PROBES; i++) {
+        if (twi_writeTo(busAddress, nop, sizeof(nop), true) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// A slave reset or glitched mid-byte holds SDA low until it has clocked the
+// rest of the byte out: up to nine SCL pulses, then a STOP by hand.
+static void recoverBus() {
+    stats.recoveries++;
+
+    pinMode(sdaPin, INPUT_PULLUP);
+    pinMode(sclPin, OUTPUT_OPEN_DRAIN);
+    for (uint8_t i = 0; i < 9 && digitalRead(sdaPin) == LOW; i++) {
+        digitalWrite(sclPin, LOW);
+        delayMicroseconds(5);
+        digitalWrite(sclPin, HIGH);
+        delayMicroseconds(5);
+    }
+
+    pinMode(sdaPin, OUTPUT_OPEN_DRAIN);
+    digitalWrite(sdaPin, LOW);
+    delayMicroseconds(5);
+    digitalWrite(sclPin, HIGH);
+    delayMicroseconds(5);
+    digitalWrite(sdaPin, HIGH);
+    delayMicroseconds(5);
+
+    twi_init(sdaPin, sclPin);
+    twi_setClock(stats.clock);
+}
+
+static void busFailed() {
+    stats.errors++;
+    failedAt = millis();
+    backingOff = true;
+
+    if (twi_status() != I2C_OK) {
+        recoverBus();
+    }
+    // repeated NACKs with a free bus: the panel can't keep up
+    if (++strikes >= OLED_BUS_STRIKES && rung + 1 < CLOCK_RUNGS) {
+        setRung(rung + 1);
+        strikes = 0;
+    }
+}
+
+/**
+ * @brief Picks the fastest clock the panel ACKs reliably
+ *
+ * Call after the panel has been initialised. Wire shares the twi driver,
+ * so the clock set here also applies to the Adafruit command writes.
+ *
+ * @return false when no clock on the ladder gets through, the slowest one
+ *         stays set then
+ */
+bool oledBusBegin(uint8_t sda, uint8_t scl, uint8_t address) {
+    sdaPin = sda;
+    sclPin = scl;
+    busAddress = address;
+    strikes = 0;
+    backingOff = false;
+
+    if (twi_status() != I2C_OK) {
+        recoverBus();
+    }
+
+    for (uint8_t i = 0; i < CLOCK_RUNGS; i++) {
+        setRung(i);
+        if (probe()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// false for OLED_BUS_BACKOFF after a failed write, so a missing panel
+// doesn't turn every loop() pass into retries
+bool oledBusReady() {
+    if (backingOff && millis() - failedAt >= OLED_BUS_BACKOFF) {
+        backingOff = false;
+    }
+    return !backingOff;
+}
+
+// a single command byte, with the same failure handling as oledBusWrite()
+bool oledBusCommand(uint8_t command) {
+    uint8_t packet[] = {CONTROL_COMMAND, command};
+
+    if (twi_writeTo(busAddress, packet, sizeof(packet), true) != 0) {
+        busFailed();
+        return false;
+    }
+    strikes = 0;
+    return true;
+}
+
+/**
+ * @brief Writes `length` bytes of display data to `page` from `column` on
+ * (panel RAM column, offset included) in one transaction
+ *
+ * A failure is counted and the bus recovered if a line is stuck. After
+ * OLED_BUS_STRIKES failures in a row the clock drops a rung.
+ *
+ * @return false when the panel didn't ACK, what it got is unknown then
+ */
+bool oledBusWrite(uint8_t page, uint8_t column, const uint8_t *data,
+                  uint8_t length) {
+    uint8_t header[SEGMENT_HEADER] = {
+        CONTROL_COMMAND, (uint8_t)(0xB0 + page),
+        CONTROL_COMMAND, (uint8_t)(0x10 + (column >> 4)),
+        CONTROL_COMMAND, (uint8_t)(column & 0x0F),
+        CONTROL_DATA,
+    };
+    memcpy(tx, header, SEGMENT_HEADER);
+    memcpy(tx + SEGMENT_HEADER, data, length);
+
+    if (twi_writeTo(busAddress, tx, SEGMENT_HEADER + length, true) != 0) {
+        busFailed();
+        return false;
+    }
+    strikes = 0;
+    return true;
+}
+
+/**
+ * @brief Rewrites `frame` to the panel OLED_BUS_TEST_FRAMES times and
+ * measures the display data throughput
+ *
+ * Pass what the panel already shows and nothing visibly changes.
+ *
+ * @return display data bytes per second, 0 when a write failed
+ */
+uint32_t oledBusSelfTest(const uint8_t *frame, uint8_t columnOffset) {
+    uint32_t bytes = 0;
+    unsigned long start = micros();
+
+    for (uint8_t i = 0; i < OLED_BUS_TEST_FRAMES; i++) {
+        for (uint8_t page = 0; page < SCREEN_HEIGHT / 8; page++) {
+            if (!oledBusWrite(page, columnOffset, frame + page * SCREEN_WIDTH,
+                              SCREEN_WIDTH)) {
+                return 0;
+            }
+            bytes += SCREEN_WIDTH;
+        }
+        yield();
+    }
+
+    unsigned long elapsed = micros() - start;
+    return elapsed ? (uint64_t)bytes * 1000000 / elapsed : 0;
+}
+
+const OledBusStats &oledBusStats() { return stats; }
@@ -0,0 +1,31 @@
+#ifndef OLED_BUS_H
+#define OLED_BUS_H
+
+#include <Arduino.h>
+
+// SH1106 I2C transport on the core's twi driver instead of Wire, which
+// splits everything into BUFFER_LENGTH-sized transactions. A write of page
+// data is one transaction: the page and column commands go first with the
+// Co bit set, then a single data control byte and the whole run.
+
+constexpr uint8_t OLED_NOP = 0xE3;
+constexpr uint8_t OLED_BUS_PROBES = 8;      // NOPs a clock must get ACKed
+constexpr uint8_t OLED_BUS_STRIKES = 3;     // failures in a row to slow down
+constexpr uint16_t OLED_BUS_BACKOFF = 100;  // ms without writes after one
+constexpr uint8_t OLED_BUS_TEST_FRAMES = 8; // per throughput self-test
+
+struct OledBusStats {
+    uint32_t clock;      // Hz, as asked of the twi driver
+    uint16_t errors;     // failed transactions since boot
+    uint16_t recoveries; // times the bus had to be unstuck
+};
+
+bool oledBusBegin(uint8_t sda, uint8_t scl, uint8_t address);
+bool oledBusReady();
+bool oledBusCommand(uint8_t command);
+bool oledBusWrite(uint8_t page, uint8_t column, const uint8_t *data,
+                  uint8_t length);
+uint32_t oledBusSelfTest(const uint8_t *frame, uint8_t columnOffset);
+const OledBusStats &oledBusStats();
+
+#endif
@@ -0,0 +1,233 @@
+#include <Arduino.h>
+#include <atomic>
+
+extern "C" {
+#include <gpio.h>
+}
+
+#include "buttons.h"
+#include "config.h"
+
+// Edges are timestamped in the GPIO interrupt and pushed into a
+// single-producer/single-consumer ring; buttonNext() turns them into
+// debounced events on the loop() side. Nothing is lost while loop() is busy,
+// the edges just wait in the ring with their original timestamps.
+
+constexpr uint8_t BUTTON_COUNT = 4;
+constexpr uint8_t EDGE_QUEUE = 32; // power of two
+constexpr uint8_t EVENT_QUEUE = 16;
+
+const uint8_t buttonPins[BUTTON_COUNT] = {BTN_UP, BTN_DOWN, BTN_OK, BTN_BACK};
+
+struct Edge {
+    unsigned long time;
+    uint8_t button;
+    bool pressed;
+};
+
+// ring shared with the ISR: only the ISR moves edgeHead, only loop() moves
+// edgeTail, each publishes with release and reads the other with acquire
+static Edge edges[EDGE_QUEUE];
+static std::atomic<uint8_t> edgeHead(0);
+static std::atomic<uint8_t> edgeTail(0);
+static uint8_t isrLevels = 0; // pressed bit per button, as the ISR saw it
+
+// loop() side state per button
+struct ButtonState {
+    bool raw;                 // level of the last edge
+    unsigned long rawTime;    // when that edge came
+    bool down;                // debounced level
+    unsigned long changed;    // when `down` last changed
+    unsigned long nextRepeat; // when the next REPEAT is due
+    bool longSent;
+};
+
+static ButtonState buttons[BUTTON_COUNT];
+
+static ButtonEvent events[EVENT_QUEUE];
+static uint8_t eventHead = 0;
+static uint8_t eventCount = 0;
+
+/**
+ * @brief GPIO interrupt shared by all buttons
+ *
+ * Reads all four lines and queues an edge for every one that changed since
+ * the last interrupt. When the ring is full the edge is dropped; loop()
+ * re-reads the pins once the ring is drained, so the level still ends up
+ * right.
+ */
+static void IRAM_ATTR onButtonEdge() {
+    unsigned long now = millis();
+
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        bool pressed = digitalRead(buttonPins[i]) == LOW;
+        if (pressed == (bool)(isrLevels & (1 << i))) {
+            continue;
+        }
+
+        uint8_t head = edgeHead.load(std::memory_order_relaxed);
+        uint8_t next = (head + 1) & (EDGE_QUEUE - 1);
+        if (next == edgeTail.load(std::memory_order_acquire)) {
+            return; // full, keep isrLevels so the edge is seen again
+        }
+
+        isrLevels ^= 1 << i;
+        edges[head] = {now, i, pressed};
+        edgeHead.store(next, std::memory_order_release);
+    }
+}
+
+/**
+ * @brief Configures the button pins and hooks up their interrupts
+ */
+void buttonsBegin() {
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        pinMode(buttonPins[i], INPUT_PULLUP);
+        buttons[i] = {false, 0, false, 0, 0, false};
+    }
+    for (uint8_t pin : buttonPins) {
+        attachInterrupt(digitalPinToInterrupt(pin), onButtonEdge, CHANGE);
+    }
+}
+
+/**
+ * @brief Lets any button wake the chip from light sleep
+ *
+ * Buttons pull their pin low, so each pin is armed for a low level. This
+ * replaces the edge interrupt of the pin until buttonsDisarmWakeup().
+ */
+void buttonsArmWakeup() {
+    for (uint8_t pin : buttonPins) {
+        gpio_pin_wakeup_enable(GPIO_ID_PIN(pin), GPIO_PIN_INTR_LOLEVEL);
+    }
+}
+
+// back to edge interrupts, a held low-level one would fire continuously
+void buttonsDisarmWakeup() {
+    gpio_pin_wakeup_disable();
+    for (uint8_t pin : buttonPins) {
+        attachInterrupt(digitalPinToInterrupt(pin), onButtonEdge, CHANGE);
+    }
+}
+
+static void pushEvent(uint8_t button, ButtonAction action,
+                      unsigned long time) {
+    if (eventCount == EVENT_QUEUE) {
+        return;
+    }
+    uint8_t slot = (eventHead + eventCount) % EVENT_QUEUE;
+    events[slot] = {buttonPins[button], action, time};
+    eventCount++;
+}
+
+static void commit(uint8_t button, bool down, unsigned long time) {
+    ButtonState &state = buttons[button];
+    state.down = down;
+    state.changed = time;
+
+    if (down) {
+        state.nextRepeat = time + BUTTON_REPEAT_DELAY;
+        state.longSent = false;
+        pushEvent(button, BUTTON_PRESS, time);
+    } else {
+        pushEvent(button, BUTTON_RELEASE, time);
+    }
+}
+
+// the first edge after a quiet BUTTON_DEBOUNCE counts right away, bounces
+// after it are ignored
+static void applyEdge(const Edge &edge) {
+    ButtonState &state = buttons[edge.button];
+    state.raw = edge.pressed;
+    state.rawTime = edge.time;
+
+    if (edge.pressed != state.down &&
+        edge.time - state.changed >= BUTTON_DEBOUNCE) {
+        commit(edge.button, edge.pressed, edge.time);
+    }
+}
+
+// catches a level the leading edge logic skipped (a bounce that ended on
+// the other level) and runs the long press / repeat timers
+static void updateButton(uint8_t button, unsigned long now) {
+    ButtonState &state = buttons[button];
+
+    if (state.raw != state.down && now - state.rawTime >= BUTTON_DEBOUNCE &&
+        now - state.changed >= BUTTON_DEBOUNCE) {
+        commit(button, state.raw, state.rawTime);
+    }
+    if (!state.down) {
+        return;
+    }
+
+    unsigned long held = now - state.changed;
+    if (!state.longSent && held >= BUTTON_LONG_PRESS) {
+        state.longSent = true;
+        pushEvent(button, BUTTON_LONG, now);
+    }
+
+    // one repeat per call at most, a stalled loop() must not burst them
+    if ((long)(now - state.nextRepeat) >= 0) {
+        unsigned long interval = held >= BUTTON_REPEAT_FAST_AFTER
+                                     ? BUTTON_REPEAT_FAST
+                                     : BUTTON_REPEAT_SLOW;
+        state.nextRepeat = now + interval;
+        pushEvent(button, BUTTON_REPEAT, now);
+    }
+}
+
+// picks up a change whose edge was dropped on a full ring
+static void resyncLevels(unsigned long now) {
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        bool pressed = digitalRead(buttonPins[i]) == LOW;
+        if (pressed != buttons[i].raw &&
+            now - buttons[i].rawTime >= BUTTON_DEBOUNCE) {
+            noInterrupts();
+            isrLevels = (isrLevels & ~(1 << i)) | (pressed << i);
+            interrupts();
+            applyEdge({now, i, pressed});
+        }
+    }
+}
+
+static void drainEdges() {
+    uint8_t tail = edgeTail.load(std::memory_order_relaxed);
+    uint8_t head = edgeHead.load(std::memory_order_acquire);
+    bool full = ((head + 1) & (EDGE_QUEUE - 1)) == tail;
+
+    while (tail != head && eventCount < EVENT_QUEUE) {
+        applyEdge(edges[tail]);
+        tail = (tail + 1) & (EDGE_QUEUE - 1);
+        edgeTail.store(tail, std::memory_order_release);
+    }
+
+    unsigned long now = millis();
+    if (full && tail == head) {
+        resyncLevels(now);
+    }
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        updateButton(i, now);
+    }
+}
+
+/**
+ * @brief Takes the next button event, oldest first
+ *
+ * Call in a loop until it returns false; each call that finds the event
+ * queue empty first drains the edge ring and runs the timers.
+ *
+ * @return false when there is nothing left to handle this tick
+ */
+bool buttonNext(ButtonEvent &event) {
+    if (!eventCount) {
+        drainEdges();
+    }
+    if (!eventCount) {
+        return false;
+    }
+
+    event = events[eventHead];
+    eventHead = (eventHead + 1) % EVENT_QUEUE;
+    eventCount--;
+    return true;
+}
@@ -0,0 +1,31 @@
+#ifndef BUTTONS_H
+#define BUTTONS_H
+
+#include <stdint.h>
+
+constexpr unsigned long BUTTON_DEBOUNCE = 30;        // ms, per button
+constexpr unsigned long BUTTON_LONG_PRESS = 700;     // ms held until LONG
+constexpr unsigned long BUTTON_REPEAT_DELAY = 400;   // ms held until REPEAT
+constexpr unsigned long BUTTON_REPEAT_SLOW = 100;    // ms between repeats
+constexpr unsigned long BUTTON_REPEAT_FAST = 40;     // once held this long:
+constexpr unsigned long BUTTON_REPEAT_FAST_AFTER = 1500;
+
+enum ButtonAction : uint8_t {
+    BUTTON_PRESS,   // debounced press, once per push
+    BUTTON_REPEAT,  // while held, after BUTTON_REPEAT_DELAY
+    BUTTON_LONG,    // once per push, after BUTTON_LONG_PRESS
+    BUTTON_RELEASE,
+};
+
+struct ButtonEvent {
+    uint8_t pin; // BTN_* from config.h
+    ButtonAction action;
+    unsigned long time; // millis() of the edge that caused it
+};
+
+void buttonsBegin();
+bool buttonNext(ButtonEvent &event);
+void buttonsArmWakeup();    // before light sleep
+void buttonsDisarmWakeup(); // after waking up
+
+#endif
@@ -0,0 +1,198 @@
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+
+extern "C" {
+#include <gpio.h>
+#include <user_interface.h>
+}
+
+#include "idle.h"
+#include "ui/ui.h"
+#include "wifi/scanner.h"
+#include "wifi/sniffer.h"
+
+constexpr uint8_t NO_PIN = 0xFF;
+
+static IdleConfig config = {0x80, 0, 0, false};
+static IdleState state = IDLE_ACTIVE;
+static unsigned long lastActivity = 0;
+
+// the press that turned the panel back on, swallowed up to its release
+static uint8_t wakePin = NO_PIN;
+static unsigned long wokeAt = 0;
+static bool wokeFromSleep = false;
+
+// millis() stands still in forced light sleep, the RTC doesn't
+static volatile bool wakeupPending = false;
+static uint32_t sleepRtc = 0;
+static unsigned long sleepMillis = 0;
+static uint64_t sleptMs = 0;
+
+// the SDK refused light sleep, don't retry every pass until the next input
+static bool sleepRefused = false;
+
+// A held button would keep a level wakeup interrupt firing, so the pins go
+// quiet right here; their edge interrupts come back in leaveSleep()
+static void onWakeup() {
+    gpio_pin_wakeup_disable();
+    wakeupPending = true;
+}
+
+static bool radioBusy() {
+    return scannerRunning() || scannerMonitoring() || snifferRunning();
+}
+
+static void enterSleep() {
+    wakeupPending = false;
+    sleepRtc = system_get_rtc_time();
+    sleepMillis = millis();
+
+    WiFi.mode(WIFI_OFF);
+    buttonsArmWakeup();
+    wifi_fpm_set_sleep_type(LIGHT_SLEEP_T);
+    wifi_fpm_open();
+    wifi_fpm_set_wakeup_cb(onWakeup);
+
+    if (wifi_fpm_do_sleep(FPM_SLEEP_MAX_TIME) != 0) {
+        // no sleep today, stay off and awake
+        wifi_fpm_close();
+        buttonsDisarmWakeup();
+        scannerBegin();
+        sleepRefused = true;
+        return;
+    }
+
+    state = IDLE_ASLEEP;
+    delay(10); // the chip goes to sleep in here and resumes after wakeup
+}
+
+static void leaveSleep() {
+    uint32_t ticks = system_get_rtc_time() - sleepRtc;
+    // calibration is the RTC period in µs, 12 fractional bits
+    uint64_t rtcMs =
+        (uint64_t)ticks * system_rtc_clock_cali_proc() / 4096 / 1000;
+    unsigned long awakeMs = millis() - sleepMillis;
+    sleptMs += rtcMs > awakeMs ? rtcMs - awakeMs : 0;
+
+    wifi_fpm_close();
+    buttonsDisarmWakeup();
+    scannerBegin();
+
+    wokeFromSleep = true;
+    wokeAt = millis();
+}
+
+static void wake() {
+    if (state == IDLE_ASLEEP) {
+        leaveSleep();
+    }
+    if (state >= IDLE_OFF) {
+        display.setPower(true);
+    }
+    display.setContrast(config.contrast);
+
+    state = IDLE_ACTIVE;
+    sleepRefused = false;
+    lastActivity = millis();
+}
+
+/**
+ * @brief Sets the contrast, the timeouts and whether to sleep
+ *
+ * The contrast applies right away unless the panel is dimmed or off.
+ */
+void idleConfigure(const IdleConfig &newConfig) {
+    config = newConfig;
+    if (state == IDLE_ACTIVE) {
+        display.setContrast(config.contrast);
+    }
+}
+
+/**
+ * @brief Feeds a button event to the idle timer, call for every event
+ *
+ * A press that wakes a dimmed panel also goes on to the menu, one on a
+ * panel that was off (or asleep) only brings it back.
+ *
+ * @return true when the event was used up waking the device
+ */
+bool idleActivity(const ButtonEvent &event) {
+    lastActivity = millis();
+
+    if (event.pin == wakePin) {
+        if (event.action == BUTTON_RELEASE) {
+            wakePin = NO_PIN;
+        }
+        return true;
+    }
+
+    // the press that ended light sleep shows up after wake() already ran
+    if (wokeFromSleep && event.action == BUTTON_PRESS &&
+        millis() - wokeAt < IDLE_WAKE_GRACE) {
+        wokeFromSleep = false;
+        wakePin = event.pin;
+        return true;
+    }
+    wokeFromSleep = false;
+
+    if (state == IDLE_ACTIVE) {
+        return false;
+    }
+
+    bool wasOff = state >= IDLE_OFF;
+    wake();
+    if (!wasOff) {
+        return false;
+    }
+    if (event.action != BUTTON_RELEASE) {
+        wakePin = event.pin;
+    }
+    return true;
+}
+
+/**
+ * @brief Steps through dim, off and light sleep, call once per loop() pass
+ *
+ * Each step starts when the time since the last button event passes its
+ * timeout. Light sleep follows the panel going off, unless the radio has
+ * work (a sweep, monitor mode, the sniffer) that sleep would cut short.
+ * If the SDK refuses to sleep, the panel stays off and awake until the next
+ * button event instead of trying again on every pass.
+ */
+void idleTick() {
+    if (state == IDLE_ASLEEP) {
+        if (wakeupPending) {
+            wake();
+        }
+        return;
+    }
+
+    unsigned long idle = millis() - lastActivity;
+    IdleState target = IDLE_ACTIVE;
+    if (config.dimTimeout > 0 && idle >= config.dimTimeout * 1000UL) {
+        target = IDLE_DIMMED;
+    }
+    if (config.offTimeout > 0 && idle >= config.offTimeout * 1000UL) {
+        target = IDLE_OFF;
+    }
+
+    if (target == IDLE_DIMMED && state == IDLE_ACTIVE) {
+        display.setContrast(IDLE_DIM_CONTRAST);
+        state = IDLE_DIMMED;
+    }
+    if (target == IDLE_OFF && state < IDLE_OFF) {
+        display.setPower(false);
+        state = IDLE_OFF;
+    }
+
+    if (state == IDLE_OFF && config.lightSleep && !sleepRefused &&
+        !radioBusy()) {
+        enterSleep();
+    }
+}
+
+IdleState idleState() { return state; }
+
+uint32_t idleUptime() { return (millis() + sleptMs) / 1000; }
+
+uint32_t idleSleptTime() { return sleptMs / 1000; }
@@ -0,0 +1,36 @@
+#ifndef IDLE_H
+#define IDLE_H
+
+#include <stdint.h>
+
+#include "input/buttons.h"
+
+// What the device does while nobody touches it. Input restores the panel
+// and everything behind it (menu, open screen) is kept as it was.
+enum IdleState : uint8_t {
+    IDLE_ACTIVE,
+    IDLE_DIMMED, // contrast down to IDLE_DIM_CONTRAST
+    IDLE_OFF,    // panel off (0xAE), its RAM keeps the frame
+    IDLE_ASLEEP, // panel off and the chip in light sleep until a button
+};
+
+constexpr uint8_t IDLE_DIM_CONTRAST = 0x00;
+
+// presses this soon after waking up from light sleep only wake the device
+constexpr unsigned long IDLE_WAKE_GRACE = 300;
+
+struct IdleConfig {
+    uint8_t contrast;    // while active
+    uint16_t dimTimeout; // s without input, 0 = never
+    uint16_t offTimeout; // s without input, 0 = never
+    bool lightSleep;     // once off, unless the radio is busy
+};
+
+void idleConfigure(const IdleConfig &config);
+bool idleActivity(const ButtonEvent &event);
+void idleTick();
+IdleState idleState();
+uint32_t idleUptime(); // s since boot, light sleep included
+uint32_t idleSleptTime(); // s of that spent in light sleep
+
+#endif
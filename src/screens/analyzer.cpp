@@ -0,0 +1,67 @@
+#include <Arduino.h>
+
+#include "screens.h"
+#include "ui/ui.h"
+#include "wifi/sniffer.h"
+
+static View analyzerView;
+
+// one bar per channel, height is the overlap-weighted congestion relative
+// to the busiest channel, AP count on top
+static void drawSniffer() {
+    const ChannelStats &stats = snifferStats();
+    const int barTop = 18;
+    const int barBottom = 54;
+    const int slot = 9;
+
+    drawHeader("KANALY");
+    display.setCursor(SCREEN_WIDTH - 30, 0);
+    display.print(F("->"));
+    display.print(stats.quietest);
+
+    // small floor so a near-silent band doesn't draw full-height bars
+    uint16_t peak = 40;
+    for (int i = 0; i < SCAN_CHANNELS; i++) {
+        peak = max(peak, stats.busy[i]);
+    }
+
+    for (int i = 0; i < SCAN_CHANNELS; i++) {
+        int x = 4 + i * slot;
+        int height = (uint32_t)stats.busy[i] * (barBottom - barTop) / peak;
+        int y = barBottom - height;
+
+        if (i + SCAN_FIRST_CHANNEL == stats.quietest) {
+            display.drawRect(x, y, slot - 2, height + 1, SH110X_WHITE);
+        } else {
+            display.fillRect(x, y, slot - 2, height + 1, SH110X_WHITE);
+        }
+
+        if (stats.apCount[i] > 0) {
+            display.setCursor(x + 1, y - 9);
+            if (stats.apCount[i] > 9) {
+                display.print('+');
+            } else {
+                display.print(stats.apCount[i]);
+            }
+        }
+    }
+
+    // the usual non-overlapping channels
+    static const uint8_t labels[] = {1, 6, 11};
+    for (uint8_t channel : labels) {
+        int x = 4 + (channel - SCAN_FIRST_CHANNEL) * slot;
+        display.setCursor(channel < 10 ? x + 1 : x - 2, 57);
+        display.print(channel);
+    }
+}
+
+static void updateAnalyzer() {
+    if (snifferTick()) {
+        analyzerView.invalidate();
+    }
+}
+
+const Screen analyzerScreen PROGMEM = {
+    snifferStart, snifferStop, nullptr, nullptr,
+    updateAnalyzer, drawSniffer, &analyzerView,
+};
@@ -0,0 +1,42 @@
+#include <Arduino.h>
+
+#include "screens.h"
+#include "ui/text.h"
+#include "ui/ui.h"
+
+constexpr uint8_t DEAUTH_LINES = 3;
+
+static View deauthView;
+
+static void drawDeauth() {
+    drawHeader("selectedAP");
+    // drawDecorativeLine();
+
+    int w = textWidth(selectedAP);
+
+    if (w <= SCREEN_WIDTH - 8) {
+        int x = (SCREEN_WIDTH - w) / 2;
+        int padding = 4;
+        drawSelectionBox(x - padding, 30, w + padding * 2, textHeight() + 4);
+        display.setCursor(x, 32);
+        display.print(selectedAP);
+        return;
+    }
+
+    // centered lines, a 32 character SSID takes two
+    TextSpan lines[DEAUTH_LINES];
+    uint8_t count = textWrap(selectedAP, SCREEN_WIDTH - 12, lines,
+                             DEAUTH_LINES);
+    int cursorY = 26;
+
+    for (uint8_t i = 0; i < count; i++) {
+        int lineWidth = textWidth(lines[i].text, lines[i].length);
+        display.setCursor((SCREEN_WIDTH - lineWidth) / 2, cursorY);
+        textPrint(lines[i]);
+        cursorY += textHeight() + 2;
+    }
+}
+
+const Screen deauthScreen PROGMEM = {
+    nullptr, nullptr, nullptr, nullptr, nullptr, drawDeauth, &deauthView,
+};
@@ -0,0 +1,74 @@
+#include <Arduino.h>
+
+#include "power/idle.h"
+#include "screens.h"
+#include "ui/ui.h"
+
+// A0 measures the chip's own supply instead of the pin
+ADC_MODE(ADC_VCC);
+
+// supply range mapped onto the battery estimate: a LiPo behind the board's
+// 3.3 V regulator only shows up on VCC once it sags below the dropout
+constexpr uint16_t VCC_EMPTY_MV = 2900;
+constexpr uint16_t VCC_FULL_MV = 3300;
+
+static View infoView;
+static uint32_t shownUptime = 0;
+
+static void printUptime(uint32_t seconds) {
+    char text[20];
+    snprintf(text, sizeof(text), "%lud %02lu:%02lu:%02lu",
+             (unsigned long)(seconds / 86400),
+             (unsigned long)(seconds / 3600 % 24),
+             (unsigned long)(seconds / 60 % 60),
+             (unsigned long)(seconds % 60));
+    display.print(text);
+}
+
+static void drawInfo() {
+    uint32_t uptime = idleUptime();
+    uint16_t vcc = ESP.getVcc();
+    int battery = constrain(
+        (int32_t)(vcc - VCC_EMPTY_MV) * 100 / (VCC_FULL_MV - VCC_EMPTY_MV), 0,
+        100);
+
+    drawHeader("INFO");
+    drawDecorativeLine();
+
+    display.setCursor(0, 14);
+    display.print(F("czas  "));
+    printUptime(uptime);
+
+    display.setCursor(0, 24);
+    display.print(F("sen   "));
+    display.print(uptime ? idleSleptTime() * 100 / uptime : 0);
+    display.print('%');
+
+    char text[20];
+    snprintf(text, sizeof(text), "%u.%02uV ~%d%%", vcc / 1000,
+             vcc / 10 % 100, battery);
+    display.setCursor(0, 34);
+    display.print(F("VCC   "));
+    display.print(text);
+
+    display.setCursor(0, 44);
+    display.print(F("start "));
+    display.print(bootTime);
+    display.print(F("ms"));
+
+    display.setCursor(0, 54);
+    display.print(F("RAM   "));
+    display.print(ESP.getFreeHeap());
+    display.print('B');
+}
+
+static void updateInfo() {
+    if (idleUptime() != shownUptime) {
+        shownUptime = idleUptime();
+        infoView.invalidate();
+    }
+}
+
+const Screen infoScreen PROGMEM = {
+    nullptr, nullptr, nullptr, nullptr, updateInfo, drawInfo, &infoView,
+};
@@ -0,0 +1,23 @@
+#include <Arduino.h>
+
+#include "screens.h"
+#include "ui/ui.h"
+
+static View placeholderView;
+
+// titled with the menu item that opened it
+static void drawPlaceholder() {
+    drawHeader(menuCurrentLabel());
+    drawDecorativeLine();
+
+    display.setCursor(34, 28);
+    display.print(F("wkrotce..."));
+
+    display.setCursor(25, 55);
+    display.print(F("[BACK] POWROT"));
+}
+
+const Screen placeholderScreen PROGMEM = {
+    nullptr, nullptr, nullptr, nullptr, nullptr, drawPlaceholder,
+    &placeholderView,
+};
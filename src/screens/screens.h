@@ -0,0 +1,28 @@
+#ifndef SCREENS_H
+#define SCREENS_H
+
+#include "ui/menu.h"
+#include "wifi/scanner.h"
+
+// Screens and submenus the menu tree in main.cpp links to. Each lives in
+// its own file here and keeps its state to itself, see Screen in ui/menu.h.
+
+extern const Screen wifiScanScreen;
+extern const Screen deauthScreen;
+extern const Screen analyzerScreen;
+extern const Screen infoScreen;
+extern const Screen placeholderScreen; // features without a screen yet
+
+extern char selectedAP[SSID_SIZE]; // picked on the WiFi scan screen
+
+void wifiScanResultsChanged();
+
+// the USTAWIENIA submenu, edits src/settings
+constexpr uint8_t SETTINGS_ITEMS = 9;
+extern const MenuNode settingsItems[SETTINGS_ITEMS];
+
+void applySettings();
+
+extern unsigned long bootTime; // ms from reset to an interactive menu
+
+#endif
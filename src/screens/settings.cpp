@@ -0,0 +1,126 @@
+#include <Arduino.h>
+
+#include "power/idle.h"
+#include "screens.h"
+#include "settings/settings.h"
+#include "ui/scheduler.h"
+
+// The USTAWIENIA submenu. Every edit lands in the settings cache, is
+// applied right away and saved to flash once the edits settle.
+
+constexpr char animationsLabel[] PROGMEM = "ANIMACJE";
+constexpr char animSpeedLabel[] PROGMEM = "SZYBKOSC ANIM.";
+constexpr char contrastLabel[] PROGMEM = "KONTRAST";
+constexpr char scanIntervalLabel[] PROGMEM = "INTERWAL SKANU";
+constexpr char dimTimeoutLabel[] PROGMEM = "PRZYGASZANIE";
+constexpr char offTimeoutLabel[] PROGMEM = "WYGASZANIE";
+constexpr char lightSleepLabel[] PROGMEM = "USYPIANIE";
+constexpr char fastBootLabel[] PROGMEM = "SZYBKI START";
+constexpr char monitorLabel[] PROGMEM = "MONITOR WIFI";
+
+constexpr char percentUnit[] PROGMEM = "%";
+constexpr char secondsUnit[] PROGMEM = "s";
+
+static bool animationsGet() { return settings().animations; }
+
+static void animationsSet(bool on) {
+    settingsEdit().animations = on;
+    applySettings();
+}
+
+static int16_t animSpeedGet() { return settings().animSpeed; }
+
+static void animSpeedSet(int16_t percent) {
+    settingsEdit().animSpeed = percent;
+    applySettings();
+}
+
+static int16_t contrastGet() { return settings().contrast; }
+
+static void contrastSet(int16_t level) {
+    settingsEdit().contrast = level;
+    applySettings();
+}
+
+static int16_t scanIntervalGet() { return settings().scanInterval; }
+
+static void scanIntervalSet(int16_t seconds) {
+    settingsEdit().scanInterval = seconds;
+    applySettings();
+}
+
+static int16_t dimTimeoutGet() { return settings().dimTimeout; }
+
+static void dimTimeoutSet(int16_t seconds) {
+    settingsEdit().dimTimeout = seconds;
+    applySettings();
+}
+
+static int16_t offTimeoutGet() { return settings().offTimeout; }
+
+static void offTimeoutSet(int16_t seconds) {
+    settingsEdit().offTimeout = seconds;
+    applySettings();
+}
+
+static bool lightSleepGet() { return settings().lightSleep; }
+
+static void lightSleepSet(bool on) {
+    settingsEdit().lightSleep = on;
+    applySettings();
+}
+
+// read at the next boot only
+static bool fastBootGet() { return settings().fastBoot; }
+
+static void fastBootSet(bool on) { settingsEdit().fastBoot = on; }
+
+constexpr MenuToggle animationsToggle PROGMEM = {animationsGet,
+                                                 animationsSet};
+constexpr MenuValue animSpeedValue PROGMEM = {
+    animSpeedGet, animSpeedSet, 25, 200, 25, percentUnit,
+};
+constexpr MenuValue contrastValue PROGMEM = {
+    contrastGet, contrastSet, 15, 255, 16, nullptr,
+};
+constexpr MenuValue scanIntervalValue PROGMEM = {
+    scanIntervalGet, scanIntervalSet, 5, 120, 5, secondsUnit,
+};
+constexpr MenuValue dimTimeoutValue PROGMEM = {
+    dimTimeoutGet, dimTimeoutSet, 0, 600, 15, secondsUnit,
+};
+constexpr MenuValue offTimeoutValue PROGMEM = {
+    offTimeoutGet, offTimeoutSet, 0, 1800, 30, secondsUnit,
+};
+constexpr MenuToggle lightSleepToggle PROGMEM = {lightSleepGet,
+                                                 lightSleepSet};
+constexpr MenuToggle fastBootToggle PROGMEM = {fastBootGet, fastBootSet};
+// runtime only, monitor mode always starts off
+constexpr MenuToggle monitorToggle PROGMEM = {scannerMonitoring,
+                                              scannerSetMonitor};
+
+const MenuNode settingsItems[SETTINGS_ITEMS] PROGMEM = {
+    menuToggle(animationsLabel, animationsToggle),
+    menuValue(animSpeedLabel, animSpeedValue),
+    menuValue(contrastLabel, contrastValue),
+    menuValue(scanIntervalLabel, scanIntervalValue),
+    menuValue(dimTimeoutLabel, dimTimeoutValue),
+    menuValue(offTimeoutLabel, offTimeoutValue),
+    menuToggle(lightSleepLabel, lightSleepToggle),
+    menuToggle(fastBootLabel, fastBootToggle),
+    menuToggle(monitorLabel, monitorToggle),
+};
+
+/**
+ * @brief Pushes the cached settings to the modules they configure
+ *
+ * Called once at boot after settingsBegin() and after every edit.
+ */
+void applySettings() {
+    const Settings &current = settings();
+
+    animationSetSpeed(current.animations ? current.animSpeed : 0);
+    scannerSetInterval(current.scanInterval * 1000UL);
+    idleConfigure({current.contrast, current.dimTimeout, current.offTimeout,
+                   current.lightSleep});
+}
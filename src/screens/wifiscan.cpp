@@ -0,0 +1,577 @@
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+
+#include "screens.h"
+#include "settings/settings.h"
+#include "ui/marquee.h"
+#include "ui/raster.h"
+#include "ui/text.h"
+#include "ui/ui.h"
+#include "wifi/netview.h"
+
+// WiFi scan state, the results themselves live in the scanner module.
+// Sort and filter choices survive leaving the screen.
+static NetworkView networkList = {};
+char selectedAP[SSID_SIZE] = "";
+
+// network list layout
+constexpr int LIST_ROWS = 5; // kept in view, the chips or a row sit above
+constexpr int LIST_TOP_Y = 20;
+constexpr int LIST_CHIP_Y = 9;
+constexpr int LIST_ROW_HEIGHT = 9;
+constexpr int LIST_SSID_WIDTH = 88; // up to the channel column
+constexpr int CONFIRM_SSID_WIDTH = SCREEN_WIDTH - 8;
+
+// Only the header line stays put, the chips scroll away with the list. The
+// display start line follows the scroll position, so a step only draws and
+// sends the rows coming into view and the header, which moved in panel RAM.
+// Scrolling by one row eases in a few px at a time, longer jumps are not
+// animated.
+constexpr int LIST_HEADER_HEIGHT = LIST_CHIP_Y;
+constexpr int LIST_SCROLL_STEP = 3;
+constexpr unsigned long LIST_SCROLL_FRAME = 15; // ms
+
+// cursor positions above the first list row
+constexpr int CHIP_SORT = -4;
+constexpr int CHIP_FILTER = -3;
+constexpr int CHIP_HIDDEN = -2;
+constexpr int CHIP_MONITOR = -1;
+
+static const char *const sortLabels[] = {"RSSI", "SSID", "KANAL"};
+static const char *const filterLabels[] = {"WSZ", "OTW", "ZAB"};
+
+// RSSI range mapped onto the sparkline height
+constexpr int SPARK_RSSI_MIN = -95;
+constexpr int SPARK_RSSI_MAX = -35;
+
+struct WiFiScanScreen {
+    View view;
+    bool showConfirmation;
+    unsigned long confirmationTime;
+    Marquee marquee; // the SSID being confirmed, else the cursor row's
+    int cursor;  // list position, or one of the CHIP_* values
+    int top;     // first visible list position
+    int scrollY; // px, follows top * LIST_ROW_HEIGHT
+    unsigned long scrollTime;
+    uint16_t scrollOnly;      // view version whose only change is scrollY
+    int drawnScroll;          // scrollY of the last list frame
+    unsigned long drawnFrame; // display.presents() once that frame went out
+    uint8_t focus[6]; // BSSID under the cursor, rows move between sweeps
+    bool detail;      // detail screen of the focused network
+    unsigned long detailTime;
+    unsigned long progressTime;
+    uint16_t progressFrame;
+};
+
+static WiFiScanScreen wifiScan = {};
+
+// keeps the cursor row inside the visible window
+static void scrollNetworkList() {
+    if (wifiScan.cursor < 0) {
+        wifiScan.top = 0; // the chips are above the first row
+        return;
+    }
+    if (wifiScan.cursor < wifiScan.top) {
+        wifiScan.top = wifiScan.cursor;
+    }
+    if (wifiScan.cursor >= wifiScan.top + LIST_ROWS) {
+        wifiScan.top = wifiScan.cursor - LIST_ROWS + 1;
+    }
+}
+
+// a long SSID on the cursor row scrolls inside the SSID column
+static void restartRowMarquee() {
+    const NetworkTable &networks = scannerTable();
+    int row = scannerFind(wifiScan.focus);
+    uint16_t width = 0;
+
+    if (wifiScan.cursor >= 0 && row >= 0 && !networks.hidden[row]) {
+        width = textWidth(networks.ssid[row]);
+    }
+    marqueeStart(wifiScan.marquee, width, LIST_SSID_WIDTH);
+}
+
+// remembers which network the cursor is on by BSSID
+static void focusCursorRow() {
+    if (wifiScan.cursor >= 0 && wifiScan.cursor < networkList.count) {
+        uint8_t row = networkList.order[wifiScan.cursor];
+        if (memcmp(wifiScan.focus, scannerTable().bssid[row], 6) != 0) {
+            memcpy(wifiScan.focus, scannerTable().bssid[row], 6);
+            restartRowMarquee();
+        }
+    }
+}
+
+// re-sorts after new results or a sort/filter change, the cursor stays on
+// the same network when it is still listed
+static void rebuildNetworkList() {
+    networkViewBuild(networkList, scannerTable());
+
+    if (wifiScan.cursor >= 0) {
+        int row = scannerFind(wifiScan.focus);
+        int pos = row >= 0 ? networkViewFind(networkList, row) : -1;
+        if (pos >= 0) {
+            wifiScan.cursor = pos;
+        } else if (wifiScan.cursor >= networkList.count) {
+            wifiScan.cursor = max(networkList.count - 1, 0);
+        }
+        focusCursorRow();
+    }
+
+    int maxTop = max(0, networkList.count - LIST_ROWS);
+    wifiScan.top = min(wifiScan.top, maxTop);
+    scrollNetworkList();
+
+    wifiScan.view.invalidate();
+}
+
+static void drawNetworkRow(int y, uint8_t row, bool selected) {
+    const NetworkTable &networks = scannerTable();
+
+    if (selected) {
+        rasterFillRect(0, y - 1, SCREEN_WIDTH, LIST_ROW_HEIGHT, SH110X_WHITE);
+        display.setTextColor(SH110X_BLACK);
+    }
+
+    // a row still scrolling in at the bottom is drawn cut, not as a marquee
+    bool marquee = selected && wifiScan.marquee.overflow &&
+                   y <= SCREEN_HEIGHT - CLASSIC_HEIGHT;
+
+    display.setCursor(2, y);
+    if (networks.hidden[row]) {
+        display.print(F("<ukryta>"));
+    } else if (marquee) {
+        const char *ssid = networks.ssid[row];
+        marqueeDraw(wifiScan.marquee, ssid, strlen(ssid), 2, y,
+                    LIST_SSID_WIDTH, true);
+    } else {
+        const char *ssid = networks.ssid[row];
+        TextSpan span = {ssid, (uint8_t)strlen(ssid)};
+        bool cut = textEllipsize(span, LIST_SSID_WIDTH);
+        textPrint(span, cut);
+    }
+
+    // right-aligned channel and signal columns
+    display.setCursor(networks.channel[row] < 10 ? 98 : 92, y);
+    display.print(networks.channel[row]);
+    display.setCursor(SCREEN_WIDTH - 18, y);
+    display.print(networks.rssi[row] < -99 ? -99 : networks.rssi[row]);
+
+    if (selected) {
+        display.setTextColor(SH110X_WHITE);
+    }
+}
+
+static void drawListChip(int x, int y, int w, const char *label,
+                         bool selected) {
+    if (selected) {
+        rasterFillRect(x, y, w, 9, SH110X_WHITE);
+        display.setTextColor(SH110X_BLACK);
+    } else {
+        drawSelectionBox(x, y, w - 1, 8);
+    }
+
+    display.setCursor(x + 2, y + 1);
+    display.print(label);
+    display.setTextColor(SH110X_WHITE);
+}
+
+static void drawListChips(int y) {
+    drawListChip(0, y, 34, sortLabels[networkList.sort],
+                 wifiScan.cursor == CHIP_SORT);
+    drawListChip(37, y, 22, filterLabels[networkList.filter],
+                 wifiScan.cursor == CHIP_FILTER);
+    drawListChip(62, y, 28, networkList.showHidden ? "+UKR" : "-UKR",
+                 wifiScan.cursor == CHIP_HIDDEN);
+    drawListChip(94, y, 28, scannerMonitoring() ? "+MON" : "-MON",
+                 wifiScan.cursor == CHIP_MONITOR);
+}
+
+// Screen rows [from, to) of the list that have to be drawn this frame
+struct ListBand {
+    int from;
+    int to;
+
+    bool touches(int y, int height) const {
+        return y < to && y + height > from;
+    }
+};
+
+// A frame that only scrolled starts from the last one, which stays put in
+// panel RAM: the rows that scrolled into view are all that is missing. Any
+// other frame, or one behind a frame someone else presented, is drawn whole.
+static ListBand listBand(int scroll) {
+    int moved = scroll - wifiScan.drawnScroll;
+    bool reuse = wifiScan.scrollOnly == wifiScan.view.version &&
+                 wifiScan.drawnFrame == display.presents() &&
+                 abs(moved) < SCREEN_HEIGHT - LIST_HEADER_HEIGHT &&
+                 display.recallFrame();
+
+    wifiScan.drawnScroll = scroll;
+    wifiScan.drawnFrame = display.presents() + 1; // menuTick() presents it
+
+    if (!reuse) {
+        return {0, SCREEN_HEIGHT};
+    }
+    // scrolling down uncovers the bottom, scrolling up the rows that were
+    // under the header
+    ListBand band = {LIST_HEADER_HEIGHT, LIST_HEADER_HEIGHT - moved};
+    if (moved > 0) {
+        band = {SCREEN_HEIGHT - moved, SCREEN_HEIGHT};
+    }
+    rasterFillRect(0, band.from, SCREEN_WIDTH, band.to - band.from,
+                   SH110X_BLACK);
+    return band;
+}
+
+// Everything below the header is drawn scrollY px higher. What ends up
+// under the header is cleared again before the header goes on top.
+static void drawNetworkList() {
+    int scroll = wifiScan.scrollY;
+    display.setStartLine(scroll % SCREEN_HEIGHT);
+    ListBand band = listBand(scroll);
+
+    if (band.touches(LIST_CHIP_Y - scroll, LIST_ROW_HEIGHT)) {
+        drawListChips(LIST_CHIP_Y - scroll);
+    }
+
+    int emptyY = LIST_TOP_Y + LIST_ROW_HEIGHT * 2 - scroll;
+    if (networkList.count == 0 && band.touches(emptyY, CLASSIC_HEIGHT)) {
+        display.setCursor(20, emptyY);
+        display.print(F("brak wynikow"));
+    }
+
+    // the cursor row fills its own background, redrawing it is harmless and
+    // catches the switch from a cut SSID to the marquee
+    for (int pos = max(scroll / LIST_ROW_HEIGHT - 2, 0);
+         pos < networkList.count; pos++) {
+        int y = LIST_TOP_Y + pos * LIST_ROW_HEIGHT - scroll;
+        if (y - 1 >= SCREEN_HEIGHT) {
+            break;
+        }
+        bool selected = pos == wifiScan.cursor;
+        if (selected || band.touches(y - 1, LIST_ROW_HEIGHT)) {
+            drawNetworkRow(y, networkList.order[pos], selected);
+        }
+    }
+
+    rasterFillRect(0, 0, SCREEN_WIDTH, LIST_HEADER_HEIGHT, SH110X_BLACK);
+    drawHeader("WiFi", max(wifiScan.cursor, 0) + 1, networkList.count);
+
+    // scan still running: progress gauge between title and counter
+    if (scannerRunning()) {
+        rasterRect(40, 2, 50, 4, SH110X_WHITE);
+        rasterFillRect(40, 2, 50 * scannerChannelsDone() / SCAN_CHANNELS, 4,
+                       SH110X_WHITE);
+    }
+}
+
+static const char *encryptionLabel(uint8_t encryption) {
+    switch (encryption) {
+    case ENC_TYPE_NONE:
+        return "OTWARTA";
+    case ENC_TYPE_WEP:
+        return "WEP";
+    case ENC_TYPE_TKIP:
+        return "WPA";
+    case ENC_TYPE_CCMP:
+        return "WPA2";
+    default:
+        return "WPA/WPA2";
+    }
+}
+
+static int sparkY(int rssi, int top, int height) {
+    rssi = constrain(rssi, SPARK_RSSI_MIN, SPARK_RSSI_MAX);
+    return top + height - 1 -
+           (rssi - SPARK_RSSI_MIN) * (height - 1) /
+               (SPARK_RSSI_MAX - SPARK_RSSI_MIN);
+}
+
+// RSSI history, one sample per sweep, oldest on the left. Sweeps the AP was
+// missing from break the line
+static void drawSparkline(uint8_t row, int x, int y, int w, int h) {
+    const NetworkTable &networks = scannerTable();
+    uint8_t samples = networks.historyCount[row];
+    int step = (w - 1) / (RSSI_HISTORY - 1);
+
+    rasterHLine(x, y + h, w, SH110X_WHITE);
+
+    int prevX = -1, prevY = 0;
+    for (uint8_t i = 0; i < samples; i++) {
+        int8_t rssi = scannerHistory(row, i);
+        // newest sample is always at the right edge
+        int px = x + (RSSI_HISTORY - samples + i) * step;
+
+        if (rssi == RSSI_NONE) {
+            display.drawPixel(px, y + h - 2, SH110X_WHITE);
+            prevX = -1;
+            continue;
+        }
+
+        int py = sparkY(rssi, y, h - 2);
+        if (prevX >= 0) {
+            display.drawLine(prevX, prevY, px, py, SH110X_WHITE);
+        } else {
+            display.drawPixel(px, py, SH110X_WHITE);
+        }
+        prevX = px;
+        prevY = py;
+    }
+}
+
+static void drawNetworkDetail() {
+    const NetworkTable &networks = scannerTable();
+    int row = scannerFind(wifiScan.focus);
+
+    if (row < 0) {
+        drawHeader("WiFi");
+        display.setCursor(16, 28);
+        display.print(F("poza zasiegiem"));
+        return;
+    }
+
+    drawHeader(networks.hidden[row] ? "<ukryta>" : networks.ssid[row]);
+
+    display.setCursor(0, 10);
+    display.print(F("K"));
+    display.print(networks.channel[row]);
+    display.setCursor(24, 10);
+    display.print(encryptionLabel(networks.encryption[row]));
+    display.setCursor(SCREEN_WIDTH - 36, 10);
+    display.print(networks.rssi[row]);
+    display.print(F("dB"));
+
+    display.setCursor(0, 19);
+    for (int i = 0; i < 6; i++) {
+        if (i > 0) {
+            display.print(':');
+        }
+        if (networks.bssid[row][i] < 0x10) {
+            display.print('0');
+        }
+        display.print(networks.bssid[row][i], HEX);
+    }
+
+    drawSparkline(row, 4, 29, SCREEN_WIDTH - 8, 24);
+
+    display.setCursor(0, 56);
+    display.print(F("widziana "));
+    display.print((millis() - networks.lastSeen[row]) / 1000);
+    display.print(F("s temu"));
+}
+
+// UP/DOWN step through the list without leaving the detail screen, OK picks
+// the network
+static void networkDetailInput(uint8_t pin) {
+    int count = networkList.count;
+    if (count == 0) {
+        return;
+    }
+
+    if (pin == BTN_UP) {
+        wifiScan.cursor = (wifiScan.cursor + count - 1) % count;
+        wifiScan.showConfirmation = false;
+    }
+    if (pin == BTN_DOWN) {
+        wifiScan.cursor = (wifiScan.cursor + 1) % count;
+        wifiScan.showConfirmation = false;
+    }
+    focusCursorRow();
+    scrollNetworkList();
+
+    int row = scannerFind(wifiScan.focus);
+    if (pin == BTN_OK && row >= 0) {
+        strcpy(selectedAP, scannerTable().ssid[row]);
+        Serial.print(selectedAP);
+        wifiScan.showConfirmation = true;
+        wifiScan.confirmationTime = millis();
+        marqueeStart(wifiScan.marquee, textWidth(selectedAP),
+                     CONFIRM_SSID_WIDTH);
+    }
+
+    wifiScan.view.invalidate();
+}
+
+static void wifiScanInput(uint8_t pin) {
+    int count = networkList.count;
+
+    if (wifiScan.detail) {
+        networkDetailInput(pin);
+        return;
+    }
+
+    if (pin == BTN_UP) {
+        wifiScan.cursor--;
+        if (wifiScan.cursor < CHIP_SORT) {
+            wifiScan.cursor = count - 1;
+        }
+    }
+    if (pin == BTN_DOWN) {
+        wifiScan.cursor++;
+        if (wifiScan.cursor >= count) {
+            wifiScan.cursor = CHIP_SORT;
+        }
+    }
+    if (pin == BTN_OK) {
+        switch (wifiScan.cursor) {
+        case CHIP_SORT:
+            networkList.sort = SortMode((networkList.sort + 1) % SORT_MODES);
+            rebuildNetworkList();
+            break;
+        case CHIP_FILTER:
+            networkList.filter =
+                EncFilter((networkList.filter + 1) % FILTER_MODES);
+            rebuildNetworkList();
+            break;
+        case CHIP_HIDDEN:
+            networkList.showHidden = !networkList.showHidden;
+            rebuildNetworkList();
+            break;
+        case CHIP_MONITOR:
+            scannerSetMonitor(!scannerMonitoring());
+            break;
+        default:
+            if (wifiScan.cursor < count) {
+                wifiScan.detail = true;
+                wifiScan.detailTime = millis();
+            }
+            break;
+        }
+    }
+
+    scrollNetworkList();
+    focusCursorRow();
+    wifiScan.view.invalidate();
+}
+
+static bool wifiScanBack() {
+    if (!wifiScan.detail) {
+        return false;
+    }
+    wifiScan.detail = false;
+    wifiScan.showConfirmation = false;
+    restartRowMarquee();
+    wifiScan.view.invalidate();
+    return true;
+}
+
+// moves scrollY towards the top row, one LIST_SCROLL_STEP per frame
+static void scrollListTick() {
+    int distance = wifiScan.top * LIST_ROW_HEIGHT - wifiScan.scrollY;
+    if (distance == 0) {
+        return;
+    }
+
+    if (!settings().animations || abs(distance) > LIST_ROW_HEIGHT) {
+        wifiScan.scrollY += distance;
+    } else if (millis() - wifiScan.scrollTime >= LIST_SCROLL_FRAME) {
+        wifiScan.scrollTime = millis();
+        wifiScan.scrollY +=
+            constrain(distance, -LIST_SCROLL_STEP, LIST_SCROLL_STEP);
+    } else {
+        return;
+    }
+
+    bool clean = !wifiScan.view.needsRedraw();
+    wifiScan.view.invalidate();
+    wifiScan.scrollOnly = clean ? wifiScan.view.version : 0;
+}
+
+static void updateWiFiScan() {
+    scrollListTick();
+
+    // bouncing dots on the progress screen
+    if (scannerRunning() && scannerCount() == 0 &&
+        millis() - wifiScan.progressTime > 120) {
+        wifiScan.progressTime = millis();
+        wifiScan.progressFrame++;
+        wifiScan.view.invalidate();
+    }
+
+    // "seen Ns ago" on the detail screen
+    if (wifiScan.detail && millis() - wifiScan.detailTime >= 1000) {
+        wifiScan.detailTime = millis();
+        wifiScan.view.invalidate();
+    }
+
+    // the list's marquee is not on screen behind the detail page
+    bool marqueeShown = wifiScan.showConfirmation ||
+                        (!wifiScan.detail && wifiScan.cursor >= 0);
+    if (marqueeShown && marqueeTick(wifiScan.marquee)) {
+        wifiScan.view.invalidate();
+    }
+
+    // a long SSID stays until it has been read to the end once
+    if (wifiScan.showConfirmation &&
+        millis() - wifiScan.confirmationTime > 1500 &&
+        marqueeDone(wifiScan.marquee)) {
+        wifiScan.showConfirmation = false;
+        restartRowMarquee();
+        wifiScan.view.invalidate();
+    }
+}
+
+static void drawWiFiScan() {
+    display.setStartLine(0); // the list sets its own
+
+    if (wifiScan.showConfirmation) {
+        display.setTextSize(1);
+        display.setCursor((SCREEN_WIDTH - textWidthOf("WYBRANO")) / 2, 20);
+        display.print("WYBRANO");
+
+        if (wifiScan.marquee.overflow == 0) {
+            display.setCursor((SCREEN_WIDTH - textWidth(selectedAP)) / 2, 42);
+            display.print(selectedAP);
+        } else {
+            marqueeDraw(wifiScan.marquee, selectedAP, strlen(selectedAP),
+                        (SCREEN_WIDTH - CONFIRM_SSID_WIDTH) / 2, 42,
+                        CONFIRM_SSID_WIDTH);
+        }
+    } else if (wifiScan.detail) {
+        drawNetworkDetail();
+    } else if (scannerCount() == 0) {
+        if (scannerRunning()) {
+            drawScanProgress(scannerChannelsDone() * 100 / SCAN_CHANNELS,
+                             wifiScan.progressFrame);
+        } else {
+            drawHeader("Brak WiFi");
+            // drawDecorativeLine();
+            display.setCursor(20, 28);
+            display.println("brak sieci...");
+            display.setCursor(48, 42);
+            display.print("(>_<)");
+        }
+    } else {
+        // the list grows while channels land
+        drawNetworkList();
+    }
+}
+
+static void enterWiFiScan() {
+    wifiScan = WiFiScanScreen();
+    scannerStart();
+    rebuildNetworkList();
+}
+
+// monitor mode keeps scanning in the background
+static void leaveWiFiScan() {
+    display.setStartLine(0);
+
+    if (!scannerMonitoring()) {
+        scannerAbort();
+    }
+}
+
+/**
+ * @brief Re-sorts the list after the scanner landed new results
+ *
+ * Called from loop() whatever the screen, so the list is current when the
+ * screen is opened again.
+ */
+void wifiScanResultsChanged() { rebuildNetworkList(); }
+
+const Screen wifiScanScreen PROGMEM = {
+    enterWiFiScan, leaveWiFiScan, wifiScanInput, wifiScanBack,
+    updateWiFiScan, drawWiFiScan, &wifiScan.view,
+};
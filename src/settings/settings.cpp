@@ -0,0 +1,209 @@
+#include <Arduino.h>
+#include <flash_hal.h>
+#include <stddef.h>
+
+#include "settings.h"
+
+// Records are appended to one of two sectors at the end of the filesystem
+// area, which this firmware doesn't otherwise use. Once a sector is full
+// the next record starts the other one, erased right before, so a sector
+// is erased once every RECORD_SLOTS saves and the previous record always
+// survives a power cut during a write or an erase.
+constexpr uint16_t RECORD_MAGIC = 0x564B; // "KV"
+constexpr uint8_t SETTINGS_VERSION = 3;
+constexpr uint8_t STORE_SECTORS = 2;
+
+struct SettingsRecord {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t size;      // sizeof(Settings) of the firmware that wrote it
+    uint32_t sequence; // higher is newer, across both sectors
+    Settings settings;
+    uint32_t crc; // CRC-32 of everything above
+};
+
+// flash is read and written in aligned 32-bit words
+static_assert(sizeof(SettingsRecord) % 4 == 0, "record must be word sized");
+
+constexpr uint16_t RECORD_SLOTS = SPI_FLASH_SEC_SIZE / sizeof(SettingsRecord);
+
+static Settings current = SETTINGS_DEFAULTS;
+static Settings saved = SETTINGS_DEFAULTS; // what the newest record holds
+static bool dirty = false;
+static unsigned long changedAt = 0;
+
+static bool storeUsable = false;
+static uint32_t sequence = 0;
+static uint8_t activeSector = 0; // 0 or 1 within the store
+static uint16_t usedSlots = RECORD_SLOTS; // in the active sector
+
+static uint32_t storeBase() {
+    return FS_PHYS_ADDR + FS_PHYS_SIZE - STORE_SECTORS * SPI_FLASH_SEC_SIZE;
+}
+
+static uint32_t slotAddress(uint8_t sector, uint16_t slot) {
+    return storeBase() + sector * SPI_FLASH_SEC_SIZE +
+           slot * sizeof(SettingsRecord);
+}
+
+static uint32_t crc32Of(const uint8_t *data, size_t length) {
+    uint32_t crc = 0xFFFFFFFF;
+    while (length--) {
+        crc ^= *data++;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+static uint32_t recordCrc(const SettingsRecord &record) {
+    return crc32Of((const uint8_t *)&record, offsetof(SettingsRecord, crc));
+}
+
+static bool recordValid(const SettingsRecord &record) {
+    return record.magic == RECORD_MAGIC &&
+           record.version == SETTINGS_VERSION &&
+           record.size == sizeof(Settings) && record.crc == recordCrc(record);
+}
+
+// Counts the written slots of `sector` and returns the sequence of the last
+// one. Slots fill front to back and an erased slot reads 0xFF, so only the
+// 8-byte headers are read here.
+static uint16_t sectorUsed(uint8_t sector, uint32_t &lastSequence) {
+    uint32_t header[2];
+    uint16_t used = 0;
+
+    lastSequence = 0;
+    while (used < RECORD_SLOTS) {
+        ESP.flashRead(slotAddress(sector, used), header, sizeof(header));
+        if ((header[0] & 0xFFFF) != RECORD_MAGIC) {
+            break;
+        }
+        lastSequence = header[1];
+        used++;
+    }
+    return used;
+}
+
+static bool loadNewest(uint8_t sector, uint16_t used) {
+    SettingsRecord record;
+
+    for (int slot = used - 1; slot >= 0; slot--) {
+        ESP.flashRead(slotAddress(sector, slot), (uint32_t *)&record,
+                      sizeof(record));
+        if (recordValid(record)) {
+            current = record.settings;
+            saved = record.settings;
+            sequence = record.sequence;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Finds the newest settings record and loads it into the RAM cache
+ *
+ * Only record headers are scanned, the record itself is fetched with a
+ * single flash read. A record torn by a power cut fails its CRC and the one
+ * before it is used instead, with nothing usable the defaults apply.
+ */
+void settingsBegin() {
+    current = SETTINGS_DEFAULTS;
+    saved = SETTINGS_DEFAULTS;
+    dirty = false;
+
+    storeUsable = FS_PHYS_SIZE >= STORE_SECTORS * SPI_FLASH_SEC_SIZE;
+    if (!storeUsable) {
+        return;
+    }
+
+    uint32_t lastSequence[STORE_SECTORS];
+    uint16_t used[STORE_SECTORS];
+    for (uint8_t i = 0; i < STORE_SECTORS; i++) {
+        used[i] = sectorUsed(i, lastSequence[i]);
+    }
+
+    // newest sector first, the other one still holds older records
+    uint8_t newest = lastSequence[1] > lastSequence[0] ? 1 : 0;
+    for (uint8_t i = 0; i < STORE_SECTORS; i++) {
+        uint8_t sector = (newest + i) % STORE_SECTORS;
+        if (loadNewest(sector, used[sector])) {
+            activeSector = sector;
+            usedSlots = used[sector];
+            return;
+        }
+    }
+
+    // nothing usable, whatever is there gets erased by the first save
+    activeSector = 0;
+    usedSlots = RECORD_SLOTS;
+}
+
+const Settings &settings() { return current; }
+
+/**
+ * @brief Gives write access to the cached settings
+ *
+ * The change is written to flash SETTINGS_SAVE_DELAY after the last call,
+ * by settingsTick().
+ */
+Settings &settingsEdit() {
+    dirty = true;
+    changedAt = millis();
+    return current;
+}
+
+// writes pending edits once they have settled, call once per loop() pass
+void settingsTick() {
+    if (dirty && millis() - changedAt >= SETTINGS_SAVE_DELAY) {
+        settingsSave();
+    }
+}
+
+/**
+ * @brief Appends the cached settings as a new record
+ *
+ * Nothing is written when they match the newest record already in flash.
+ *
+ * @return false when the store is unusable or the flash write failed, the
+ *         settings then only live until the next reset
+ */
+bool settingsSave() {
+    dirty = false;
+    if (!storeUsable) {
+        return false;
+    }
+    if (memcmp(&current, &saved, sizeof(Settings)) == 0) {
+        return true;
+    }
+
+    if (usedSlots >= RECORD_SLOTS) {
+        activeSector = (activeSector + 1) % STORE_SECTORS;
+        uint32_t sector = slotAddress(activeSector, 0) / SPI_FLASH_SEC_SIZE;
+        if (!ESP.flashEraseSector(sector)) {
+            return false;
+        }
+        usedSlots = 0;
+    }
+
+    SettingsRecord record;
+    memset(&record, 0, sizeof(record)); // padding is covered by the CRC
+    record.magic = RECORD_MAGIC;
+    record.version = SETTINGS_VERSION;
+    record.size = sizeof(Settings);
+    record.sequence = sequence + 1;
+    record.settings = current;
+    record.crc = recordCrc(record);
+
+    // the slot is used up even if the write fails halfway
+    uint32_t address = slotAddress(activeSector, usedSlots++);
+    if (!ESP.flashWrite(address, (const uint32_t *)&record, sizeof(record))) {
+        return false;
+    }
+
+    sequence = record.sequence;
+    saved = current;
+    return true;
+}
@@ -0,0 +1,35 @@
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+#include <stdint.h>
+
+// User settings, cached in RAM and persisted to flash by the store in
+// settings.cpp. Appending a field keeps old records readable only if
+// SETTINGS_VERSION is bumped and the loader taught about the old layout,
+// otherwise they are dropped and the defaults apply.
+struct Settings {
+    bool animations;      // off = every animation jumps to its end
+    uint8_t animSpeed;    // percent of the normal speed
+    uint8_t contrast;     // SH1106 contrast register
+    uint8_t scanInterval; // s between background monitor sweeps
+    uint16_t dimTimeout;  // s without input before dimming, 0 = never
+    uint16_t offTimeout;  // s without input before the panel goes off
+    bool fastBoot;        // straight to the menu, no startup animation
+    bool lightSleep;      // sleep while the panel is off and the radio idle
+};
+
+constexpr Settings SETTINGS_DEFAULTS = {
+    true, 100, 0x80, 15, 60, 300, false, true,
+};
+
+// edits are written this long after the last change, so stepping a value
+// with UP/DOWN costs one flash write instead of one per step
+constexpr unsigned long SETTINGS_SAVE_DELAY = 3000;
+
+void settingsBegin();
+const Settings &settings();
+Settings &settingsEdit(); // schedules a save
+void settingsTick();
+bool settingsSave();
+
+#endif
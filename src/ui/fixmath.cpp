@@ -0,0 +1,61 @@
+#include <Arduino.h>
+
+#include "fixmath.h"
+
+// quarter wave, one entry per degree, the other quadrants are mirrored
+struct SineTable {
+    int16_t q[91];
+};
+
+// Taylor series, only ever evaluated by the compiler
+static constexpr double taylorSin(double x) {
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 12; n++) {
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+static constexpr SineTable makeSineTable() {
+    SineTable table = {};
+    for (int deg = 0; deg <= 90; deg++) {
+        table.q[deg] = (int16_t)(taylorSin(deg * 3.14159265358979 / 180.0) *
+                                     FIX_ONE +
+                                 0.5);
+    }
+    return table;
+}
+
+static constexpr SineTable sineTable PROGMEM = makeSineTable();
+
+static_assert(sineTable.q[0] == 0, "sin(0)");
+static_assert(sineTable.q[30] == FIX_ONE / 2, "sin(30)");
+static_assert(sineTable.q[90] == FIX_ONE, "sin(90)");
+
+/**
+ * @brief Table sine
+ *
+ * @param degrees Any angle in degrees, negative and > 360 are wrapped
+ * @return sin(degrees) in Q2.14, FIX_ONE == 1.0
+ */
+int16_t fixSin(int degrees) {
+    degrees %= 360;
+    if (degrees < 0) {
+        degrees += 360;
+    }
+
+    bool negative = degrees >= 180;
+    if (negative) {
+        degrees -= 180;
+    }
+    if (degrees > 90) {
+        degrees = 180 - degrees;
+    }
+
+    int16_t value = pgm_read_word(&sineTable.q[degrees]);
+    return negative ? -value : value;
+}
+
+int16_t fixCos(int degrees) { return fixSin(degrees + 90); }
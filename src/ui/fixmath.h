@@ -0,0 +1,36 @@
+#ifndef FIXMATH_H
+#define FIXMATH_H
+
+#include <stdint.h>
+
+// Q2.14 fixed point, FIX_ONE == 1.0. The ESP8266 has no FPU, every float
+// sin()/cos() is a soft-float routine - animations use these instead.
+constexpr int FIX_SHIFT = 14;
+constexpr int16_t FIX_ONE = 1 << FIX_SHIFT;
+
+struct Vec2 {
+    int16_t x;
+    int16_t y;
+};
+
+int16_t fixSin(int degrees);
+int16_t fixCos(int degrees);
+
+// value * q, rounded back to an integer
+inline int fixMul(int value, int16_t q) {
+    return (value * (int32_t)q + (1 << (FIX_SHIFT - 1))) >> FIX_SHIFT;
+}
+
+// point `radius` pixels away from `origin` in direction `degrees`
+inline Vec2 fixPolar(Vec2 origin, int degrees, int radius) {
+    return {(int16_t)(origin.x + fixMul(radius, fixCos(degrees))),
+            (int16_t)(origin.y + fixMul(radius, fixSin(degrees)))};
+}
+
+// |sin| scaled to 0..height, for things that hop
+inline int fixBounce(int degrees, int height) {
+    int16_t s = fixSin(degrees);
+    return fixMul(height, s < 0 ? -s : s);
+}
+
+#endif
@@ -0,0 +1,121 @@
+#include <Arduino.h>
+
+// The 5x7 glyph columns, the same table Adafruit_GFX draws from. It is a
+// static array there, so this is a second 1.3 kB copy in flash.
+#include <glcdfont.c>
+
+#include "marquee.h"
+#include "text.h"
+#include "ui.h"
+
+constexpr uint8_t GLYPH_COLUMNS = 5; // the 6th column is blank
+
+// column `col` of `c`, LSB is the top row
+static uint8_t glyphColumn(uint8_t c, uint8_t col) {
+    // same off-by-one as drawChar() without cp437(true)
+    if (c >= 176) {
+        c++;
+    }
+    return pgm_read_byte(&font[c * GLYPH_COLUMNS + col]);
+}
+
+/**
+ * @brief Restarts the scroll for a text `textWidth` px wide in a window
+ * `width` px wide
+ *
+ * The text rests at its start for MARQUEE_PAUSE first. Text that fits
+ * never moves.
+ */
+void marqueeStart(Marquee &marquee, uint16_t textWidth, uint8_t width) {
+    marquee.overflow = textWidth > width ? textWidth - width : 0;
+    marquee.offset = 0;
+    marquee.direction = 1;
+    marquee.passes = 0;
+    marquee.nextStep = millis() + MARQUEE_PAUSE;
+}
+
+/**
+ * @brief Advances the scroll, call once per loop() pass
+ *
+ * @return true when the offset changed and the window needs redrawing
+ */
+bool marqueeTick(Marquee &marquee) {
+    unsigned long now = millis();
+    if (marquee.overflow == 0 || (int32_t)(now - marquee.nextStep) < 0) {
+        return false;
+    }
+
+    // the pause at the end is over
+    if (marquee.offset == marquee.overflow) {
+        marquee.passes++;
+    }
+
+    marquee.offset += marquee.direction;
+    marquee.nextStep = now + MARQUEE_STEP;
+
+    if (marquee.offset == marquee.overflow || marquee.offset == 0) {
+        marquee.direction = -marquee.direction;
+        marquee.nextStep = now + MARQUEE_PAUSE;
+    }
+    return true;
+}
+
+// true once the end of the text has been shown for a whole pause
+bool marqueeDone(const Marquee &marquee) {
+    return marquee.overflow == 0 || marquee.passes > 0;
+}
+
+/**
+ * @brief Draws the visible window of `text` straight into the display
+ * buffer
+ *
+ * Writes glyph columns instead of going through drawChar(), so a glyph cut
+ * by either window edge costs the same as a whole one and nothing outside
+ * the window is touched. The 8-row band of the window is overwritten,
+ * background included.
+ *
+ * @param x, y     top left of the window, y anywhere from 0 to
+ *                 SCREEN_HEIGHT - 8
+ * @param inverted black text on white, for selected rows
+ *
+ * @note Does not flush the display
+ */
+void marqueeDraw(const Marquee &marquee, const char *text, size_t length,
+                 int x, int y, uint8_t width, bool inverted) {
+    if (y < 0 || y > SCREEN_HEIGHT - CLASSIC_HEIGHT) {
+        return;
+    }
+
+    uint8_t *row = display.getBuffer() + (y / 8) * SCREEN_WIDTH;
+    uint8_t shift = y % 8;
+    uint16_t mask = 0xFF << shift;
+    int left = x < 0 ? 0 : x;
+    int right = x + width > SCREEN_WIDTH ? SCREEN_WIDTH : x + width;
+
+    int column = left - x + marquee.offset;
+    size_t glyph = column / CLASSIC_ADVANCE;
+    uint8_t col = column % CLASSIC_ADVANCE;
+
+    for (int sx = left; sx < right; sx++) {
+        uint8_t bits = 0;
+        if (glyph < length && col < GLYPH_COLUMNS) {
+            bits = glyphColumn(text[glyph], col);
+        }
+        if (inverted) {
+            bits = ~bits;
+        }
+
+        // a band that isn't page aligned straddles two pages
+        uint16_t band = bits << shift;
+        row[sx] = (row[sx] & ~mask) | (band & 0xFF);
+        if (shift) {
+            uint8_t &below = row[sx + SCREEN_WIDTH];
+            below = (below & ~(mask >> 8)) | (band >> 8);
+        }
+
+        if (++col == CLASSIC_ADVANCE) {
+            col = 0;
+            glyph++;
+        }
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef MARQUEE_H
+#define MARQUEE_H
+
+#include <Arduino.h>
+
+// Text too wide for its window scrolls one pixel at a time to its end and
+// back, pausing at each end. Only the scroll state lives here, the text is
+// passed to marqueeDraw() each frame, so a row that moves in a re-sorted
+// table keeps scrolling. Built-in font at size 1 only.
+struct Marquee {
+    uint16_t overflow;      // px wider than the window, 0 = nothing to do
+    uint16_t offset;        // px scrolled
+    int8_t direction;       // 1 towards the end, -1 back
+    uint8_t passes;         // times the end was shown for a whole pause
+    unsigned long nextStep; // millis() of the next move, pauses included
+};
+
+constexpr uint16_t MARQUEE_STEP = 40;   // ms per pixel
+constexpr uint16_t MARQUEE_PAUSE = 800; // ms at each end
+
+void marqueeStart(Marquee &marquee, uint16_t textWidth, uint8_t width);
+bool marqueeTick(Marquee &marquee);
+bool marqueeDone(const Marquee &marquee);
+void marqueeDraw(const Marquee &marquee, const char *text, size_t length,
+                 int x, int y, uint8_t width, bool inverted = false);
+
+#endif
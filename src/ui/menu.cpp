@@ -0,0 +1,394 @@
+#include <Arduino.h>
+
+#include "menu.h"
+#include "raster.h"
+#include "slide.h"
+#include "text.h"
+#include "ui.h"
+
+constexpr int ITEM_Y = 32;
+constexpr int VALUE_Y = 46;
+constexpr int ITEM_PADDING = 4;
+
+// the pages the item label and its box are in, the only part that slides
+constexpr uint8_t SLIDE_FIRST_PAGE = (ITEM_Y - 2) / 8;
+constexpr uint8_t SLIDE_PAGES = (ITEM_Y + CLASSIC_HEIGHT + 2) / 8 -
+                                SLIDE_FIRST_PAGE + 1;
+static_assert(SLIDE_PAGES <= SLIDE_MAX_PAGES, "slide buffers too small");
+
+// one open submenu, the tree itself stays in flash
+struct MenuLevel {
+    const MenuNode *menu; // PROGMEM node of type NODE_SUBMENU
+    uint8_t cursor;
+    uint8_t lastCursor; // where the running slide started from
+};
+
+static MenuLevel levels[MENU_DEPTH];
+static uint8_t depth = 0;
+static const Screen *openScreen = nullptr; // PROGMEM, nullptr in the menu
+static bool editing = false;               // NODE_VALUE under the cursor
+static bool slideRight = false;
+
+// PROGMEM structs are copied out whole, flash only takes aligned 32-bit reads
+template <typename T> static T readFlash(const T *flash) {
+    T copy;
+    memcpy_P(&copy, flash, sizeof(T));
+    return copy;
+}
+
+static const __FlashStringHelper *flashText(const char *text) {
+    return (const __FlashStringHelper *)text;
+}
+
+static MenuNode levelMenu() { return readFlash(levels[depth].menu); }
+
+static const MenuNode *itemFlash(uint8_t index) {
+    return (const MenuNode *)levelMenu().target + index;
+}
+
+static MenuNode itemAt(uint8_t index) { return readFlash(itemFlash(index)); }
+
+// "WL"/"WYL" for toggles, the number and unit for values, false otherwise
+static bool formatValue(const MenuNode &node, char *text, size_t size) {
+    if (node.type == NODE_TOGGLE) {
+        MenuToggle toggle = readFlash((const MenuToggle *)node.target);
+        strncpy(text, toggle.get() ? "WL" : "WYL", size);
+        return true;
+    }
+    if (node.type == NODE_VALUE) {
+        MenuValue value = readFlash((const MenuValue *)node.target);
+        snprintf(text, size, "%d", value.get());
+        if (value.unit) {
+            strncat_P(text, value.unit, size - strlen(text) - 1);
+        }
+        return true;
+    }
+    return false;
+}
+
+static void drawItemValue(const MenuNode &node) {
+    char text[16];
+    if (!formatValue(node, text, sizeof(text))) {
+        return;
+    }
+
+    int w = textWidth(text);
+    int x = (SCREEN_WIDTH - w) / 2;
+
+    // inverted while UP/DOWN are changing it
+    if (editing) {
+        rasterFillRect(x - 3, VALUE_Y - 1, w + 6, textHeight() + 2,
+                       SH110X_WHITE);
+        display.setTextColor(SH110X_BLACK);
+    }
+    display.setCursor(x, VALUE_Y);
+    display.print(text);
+    display.setTextColor(SH110X_WHITE);
+}
+
+static void drawLevelHeader() {
+    MenuNode menu = levelMenu();
+    drawHeader(flashText(menu.label), levels[depth].cursor + 1, menu.count);
+}
+
+// label of `node` centered, in a selection box when `boxed`
+static void drawItem(const MenuNode &node, bool boxed) {
+    int w = textWidth(flashText(node.label));
+    int x = (SCREEN_WIDTH - w) / 2;
+
+    if (boxed) {
+        drawSelectionBox(x - ITEM_PADDING, ITEM_Y - 2, w + ITEM_PADDING * 2,
+                         textHeight() + 4);
+    }
+    display.setCursor(x, ITEM_Y);
+    display.print(flashText(node.label));
+}
+
+// the resting state of the current level
+static void drawLevel() {
+    MenuNode item = itemAt(levels[depth].cursor);
+
+    display.clearDisplay();
+    drawLevelHeader();
+    drawItem(item, true);
+    drawItemValue(item);
+    drawNavigationDots();
+    display.present();
+}
+
+static void drawIncomingItem() { drawItem(itemAt(levels[depth].cursor), true); }
+
+// the previous item ghost leaves without its box
+static void drawOutgoingItem() {
+    drawItem(itemAt(levels[depth].lastCursor), false);
+}
+
+// the header and the dots stay put, only the item band is composed
+static uint16_t menuSlideFrame(uint16_t frame) {
+    if (!slideCompose(frame, slideRight)) {
+        return ANIM_DONE;
+    }
+    display.present();
+    return SLIDE_FRAME_TIME;
+}
+
+// also runs when the slide is skipped or animations are off
+static void finishSlide() {
+    drawLevel();
+    levels[depth].lastCursor = levels[depth].cursor;
+}
+
+// a slide still in flight is replaced, so holding UP/DOWN never waits for
+// the previous one to finish
+static void startSlide(bool right) {
+    slideRight = right;
+
+    // the band is rendered twice here and only copied around afterwards
+    slideCapture(SLIDE_FIRST_PAGE, SLIDE_PAGES, drawOutgoingItem,
+                 drawIncomingItem);
+    display.clearDisplay();
+    drawLevelHeader();
+    drawNavigationDots();
+
+    animationStart(menuSlideFrame, finishSlide, false);
+}
+
+static void openScreenAt(const Screen *screen) {
+    Screen hooks = readFlash(screen);
+    openScreen = screen;
+
+    if (hooks.view) {
+        *hooks.view = View();
+    }
+    if (hooks.enter) {
+        hooks.enter();
+    }
+
+    // the screen itself is drawn by menuTick() once the transition is over
+    submenuEnterAnimation();
+}
+
+static void closeScreen() {
+    Screen hooks = readFlash(openScreen);
+    openScreen = nullptr;
+
+    if (hooks.leave) {
+        hooks.leave();
+    }
+}
+
+static void pushLevel(const MenuNode *menu) {
+    if (depth + 1 >= MENU_DEPTH) {
+        return;
+    }
+    depth++;
+    levels[depth] = {menu, 0, 0};
+    menuDraw();
+}
+
+// back to the root list from anywhere, the root cursor is kept
+static void menuHome() {
+    if (openScreen) {
+        closeScreen();
+    }
+    depth = 0;
+    editing = false;
+    menuDraw();
+}
+
+static void changeValue(const MenuNode &node, int direction) {
+    MenuValue value = readFlash((const MenuValue *)node.target);
+    int next = value.get() + direction * value.step;
+
+    animationSkip(); // a slide frame would paint the old item back
+    value.set(constrain(next, value.min, value.max));
+    drawLevel();
+}
+
+static void selectItem() {
+    const MenuNode *flash = itemFlash(levels[depth].cursor);
+    MenuNode item = readFlash(flash);
+
+    switch (item.type) {
+    case NODE_ACTION:
+        openScreenAt((const Screen *)item.target);
+        break;
+    case NODE_SUBMENU:
+        pushLevel(flash);
+        break;
+    case NODE_TOGGLE: {
+        // the slide still in flight ends first, its next frame would paint
+        // the old item back over the new state
+        animationSkip();
+        MenuToggle toggle = readFlash((const MenuToggle *)item.target);
+        toggle.set(!toggle.get());
+        drawLevel();
+        break;
+    }
+    case NODE_VALUE:
+        animationSkip();
+        editing = true;
+        drawLevel();
+        break;
+    }
+}
+
+static void screenButton(const ButtonEvent &event) {
+    Screen hooks = readFlash(openScreen);
+    bool press = event.action == BUTTON_PRESS;
+    bool step = press || event.action == BUTTON_REPEAT;
+
+    if (event.pin == BTN_BACK) {
+        // screens with a level of their own get the first go at BACK
+        if (press && !(hooks.back && hooks.back())) {
+            closeScreen();
+            menuDraw();
+        } else if (event.action == BUTTON_LONG) {
+            menuHome();
+        }
+        return;
+    }
+
+    if (hooks.input &&
+        ((event.pin == BTN_OK && press) || (event.pin != BTN_OK && step))) {
+        hooks.input(event.pin);
+    }
+}
+
+/**
+ * @brief Sets the tree the navigator walks, call once before menuDraw()
+ *
+ * @param root PROGMEM node of type NODE_SUBMENU, its label is the header of
+ *             the top level
+ */
+void menuBegin(const MenuNode &root) {
+    levels[0] = {&root, 0, 0};
+    depth = 0;
+    openScreen = nullptr;
+    editing = false;
+}
+
+/**
+ * @brief Slides the item under the cursor of the current level in
+ *
+ * Used after startup, after leaving a screen and when changing levels, the
+ * previous item ghost is the same item then.
+ */
+void menuDraw() {
+    MenuLevel &level = levels[depth];
+    startSlide(level.lastCursor == 0 &&
+               level.cursor == menuLevelSize() - 1);
+}
+
+/**
+ * @brief Moves the cursor of the current level by `delta`, wrapping around,
+ * and slides to the new item
+ */
+void menuStep(int delta) {
+    MenuLevel &level = levels[depth];
+    int count = menuLevelSize();
+
+    level.lastCursor = level.cursor;
+    level.cursor = (level.cursor + delta % count + count) % count;
+    startSlide(delta < 0);
+}
+
+/**
+ * @brief Handles one button event for the menu and the open screen
+ *
+ * UP/DOWN act on every press and auto-repeat, OK on the press only. BACK
+ * goes up one level, held long it returns to the top level from anywhere.
+ * A press while a modal animation runs only skips it.
+ */
+void menuButton(const ButtonEvent &event) {
+    bool press = event.action == BUTTON_PRESS;
+    bool step = press || event.action == BUTTON_REPEAT;
+
+    if (animationModal()) {
+        if (press) {
+            animationSkip();
+        }
+        return;
+    }
+
+    if (openScreen) {
+        screenButton(event);
+        return;
+    }
+
+    if (event.pin == BTN_BACK) {
+        if (event.action == BUTTON_LONG) {
+            menuHome();
+        } else if (press && editing) {
+            editing = false;
+            drawLevel();
+        } else if (press && depth > 0) {
+            depth--;
+            menuDraw();
+        }
+        return;
+    }
+
+    if (editing) {
+        MenuNode item = itemAt(levels[depth].cursor);
+        if (event.pin == BTN_UP && step) {
+            changeValue(item, 1);
+        } else if (event.pin == BTN_DOWN && step) {
+            changeValue(item, -1);
+        } else if (event.pin == BTN_OK && press) {
+            editing = false;
+            drawLevel();
+        }
+        return;
+    }
+
+    if (event.pin == BTN_UP && step) {
+        menuStep(-1);
+    } else if (event.pin == BTN_DOWN && step) {
+        menuStep(1);
+    } else if (event.pin == BTN_OK && press) {
+        selectItem();
+    }
+}
+
+/**
+ * @brief Runs the open screen, call once per loop() pass after
+ * animationTick()
+ *
+ * update() runs every pass, draw() only when the screen's view changed.
+ * Nothing runs while a modal animation owns the display.
+ */
+void menuTick() {
+    if (!openScreen || animationModal()) {
+        return;
+    }
+
+    Screen hooks = readFlash(openScreen);
+    if (hooks.update) {
+        hooks.update();
+    }
+
+    // update() may have handed the screen to an animation
+    if (animationModal() || !hooks.draw ||
+        (hooks.view && !hooks.view->needsRedraw())) {
+        return;
+    }
+
+    display.clearDisplay();
+    hooks.draw();
+    display.present();
+
+    if (hooks.view) {
+        hooks.view->markDrawn();
+    }
+}
+
+uint8_t menuLevelSize() { return levelMenu().count; }
+
+const __FlashStringHelper *menuItemLabel(uint8_t index) {
+    return flashText(itemAt(index).label);
+}
+
+const __FlashStringHelper *menuCurrentLabel() {
+    return menuItemLabel(levels[depth].cursor);
+}
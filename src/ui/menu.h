@@ -0,0 +1,80 @@
+#ifndef MENU_H
+#define MENU_H
+
+#include <Arduino.h>
+
+#include "input/buttons.h"
+#include "view.h"
+
+// A full-screen page opened from the menu. Every hook is optional.
+struct Screen {
+    void (*enter)();            // fresh state, start background work
+    void (*leave)();            // stop what enter() started
+    void (*input)(uint8_t pin); // UP/DOWN presses and repeats, OK presses
+    bool (*back)();             // true when BACK was handled inside
+    void (*update)();           // timers, every loop() pass
+    void (*draw)();             // buffer is cleared and flushed around it
+    View *view;                 // draw() only runs when this needs it
+};
+
+struct MenuToggle {
+    bool (*get)();
+    void (*set)(bool on);
+};
+
+struct MenuValue {
+    int16_t (*get)();
+    void (*set)(int16_t value);
+    int16_t min;
+    int16_t max;
+    int16_t step;
+    const char *unit; // PROGMEM, may be nullptr
+};
+
+enum MenuNodeType : uint8_t {
+    NODE_ACTION,  // opens a Screen
+    NODE_SUBMENU, // a list of nodes one level down
+    NODE_TOGGLE,  // OK flips it
+    NODE_VALUE,   // OK starts editing, UP/DOWN change it, OK/BACK stop
+};
+
+// One entry of the menu tree. Trees are declared constexpr in PROGMEM with
+// the helpers below, labels are PROGMEM strings too, so the whole tree
+// lives in flash and only the navigator state takes RAM.
+struct MenuNode {
+    const char *label;
+    MenuNodeType type;
+    uint8_t count;      // children of a NODE_SUBMENU
+    const void *target; // Screen, MenuNode[], MenuToggle or MenuValue
+};
+
+constexpr MenuNode menuAction(const char *label, const Screen &screen) {
+    return {label, NODE_ACTION, 0, &screen};
+}
+
+template <uint8_t N>
+constexpr MenuNode menuSubmenu(const char *label,
+                               const MenuNode (&children)[N]) {
+    return {label, NODE_SUBMENU, N, children};
+}
+
+constexpr MenuNode menuToggle(const char *label, const MenuToggle &toggle) {
+    return {label, NODE_TOGGLE, 0, &toggle};
+}
+
+constexpr MenuNode menuValue(const char *label, const MenuValue &value) {
+    return {label, NODE_VALUE, 0, &value};
+}
+
+constexpr uint8_t MENU_DEPTH = 4;
+
+void menuBegin(const MenuNode &root);
+void menuDraw();
+void menuStep(int delta);
+void menuButton(const ButtonEvent &event);
+void menuTick();
+uint8_t menuLevelSize();
+const __FlashStringHelper *menuItemLabel(uint8_t index);
+const __FlashStringHelper *menuCurrentLabel(); // item under the cursor
+
+#endif
@@ -0,0 +1,85 @@
+#include <Arduino.h>
+
+#include "raster.h"
+#include "ui.h"
+
+// applies `mask` to `count` column bytes of one page
+static void maskColumns(uint8_t *columns, int count, uint8_t mask,
+                        uint16_t color) {
+    if (mask == 0xFF && color != SH110X_INVERSE) {
+        memset(columns, color == SH110X_WHITE ? 0xFF : 0x00, count);
+        return;
+    }
+
+    uint8_t *end = columns + count;
+    if (color == SH110X_WHITE) {
+        while (columns < end) {
+            *columns++ |= mask;
+        }
+    } else if (color == SH110X_BLACK) {
+        while (columns < end) {
+            *columns++ &= ~mask;
+        }
+    } else {
+        while (columns < end) {
+            *columns++ ^= mask;
+        }
+    }
+}
+
+/**
+ * @brief Fills a rect page by page
+ *
+ * Same pixels as display.fillRect() with the same arguments.
+ *
+ * @note Does not flush the display
+ */
+void rasterFillRect(int x, int y, int w, int h, uint16_t color) {
+    // clip
+    if (x < 0) {
+        w += x;
+        x = 0;
+    }
+    if (y < 0) {
+        h += y;
+        y = 0;
+    }
+    if (x + w > SCREEN_WIDTH) {
+        w = SCREEN_WIDTH - x;
+    }
+    if (y + h > SCREEN_HEIGHT) {
+        h = SCREEN_HEIGHT - y;
+    }
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+
+    uint8_t *buffer = display.getBuffer();
+    int bottom = y + h - 1;
+
+    for (int page = y / 8; page <= bottom / 8; page++) {
+        uint8_t mask = 0xFF;
+        if (page == y / 8) {
+            mask &= 0xFF << (y & 7);
+        }
+        if (page == bottom / 8) {
+            mask &= 0xFF >> (7 - (bottom & 7));
+        }
+        maskColumns(buffer + page * SCREEN_WIDTH + x, w, mask, color);
+    }
+}
+
+/**
+ * @brief Outlines a rect, same pixels as display.drawRect()
+ *
+ * @note Does not flush the display
+ */
+void rasterRect(int x, int y, int w, int h, uint16_t color) {
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+    rasterHLine(x, y, w, color);
+    rasterHLine(x, y + h - 1, w, color);
+    rasterVLine(x, y + 1, h - 2, color);
+    rasterVLine(x + w - 1, y + 1, h - 2, color);
+}
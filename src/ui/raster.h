@@ -0,0 +1,24 @@
+#ifndef RASTER_H
+#define RASTER_H
+
+#include <stdint.h>
+
+// Drawing straight into the SH1106 buffer layout: byte x of page p holds
+// column x of rows 8p..8p+7, LSB on top. No virtual call per pixel: a rect
+// is one masked write per column and page it touches, and the pages it
+// covers whole are memset(). Colours are SH110X_WHITE, SH110X_BLACK or
+// SH110X_INVERSE as with Adafruit_GFX, everything is clipped to the screen.
+void rasterFillRect(int x, int y, int w, int h, uint16_t color);
+void rasterRect(int x, int y, int w, int h, uint16_t color);
+
+// horizontal span, one bit in each column byte
+inline void rasterHLine(int x, int y, int w, uint16_t color) {
+    rasterFillRect(x, y, w, 1, color);
+}
+
+// vertical run, one masked byte per page
+inline void rasterVLine(int x, int y, int h, uint16_t color) {
+    rasterFillRect(x, y, 1, h, color);
+}
+
+#endif
@@ -0,0 +1,120 @@
+#include <Arduino.h>
+
+#include "scheduler.h"
+
+// single animation slot - the UI never plays two animations at once, a new
+// one simply replaces whatever is still running
+struct AnimationState {
+    AnimFrameFn frameFn;
+    AnimDoneFn doneFn;
+    uint16_t frame;
+    unsigned long nextFrameAt;
+    bool modal;
+    bool running;
+};
+
+static AnimationState anim = {nullptr, nullptr, 0, 0, false, false};
+static uint8_t speed = 100;
+
+static void finishAnimation() {
+    AnimDoneFn done = anim.doneFn;
+
+    // cleared before the callback so it can start a follow-up animation
+    anim.running = false;
+    anim.doneFn = nullptr;
+
+    if (done) {
+        done();
+    }
+}
+
+/**
+ * @brief Starts a frame-based animation driven by animationTick()
+ *
+ * @param frameFn Draws one frame and returns its hold time in ms,
+ *                or ANIM_DONE when there are no more frames
+ * @param doneFn Called once the last frame has been held, or on skip
+ * @param modal Modal animations own the screen and the buttons (loop() only
+ *              uses a press to skip them). Non-modal ones (slides) leave
+ *              input handling to the caller
+ *
+ * The first frame is drawn immediately so the screen reacts on the same tick.
+ * With animations off no frame is drawn and doneFn runs right away, like a
+ * skip.
+ *
+ * @note Replaces a running animation without calling its doneFn
+ */
+void animationStart(AnimFrameFn frameFn, AnimDoneFn doneFn, bool modal) {
+    anim = {frameFn, doneFn, 0, millis(), modal, true};
+    if (speed == 0) {
+        finishAnimation();
+        return;
+    }
+    animationTick();
+}
+
+/**
+ * @brief Advances the running animation, call once per loop() iteration
+ *
+ * Draws the next frame only when the hold time of the previous one has
+ * elapsed, so the caller never blocks.
+ *
+ * @return true while an animation is still running
+ */
+bool animationTick() {
+    if (!anim.running) {
+        return false;
+    }
+
+    unsigned long now = millis();
+    if ((long)(now - anim.nextFrameAt) < 0) {
+        return true;
+    }
+
+    uint16_t hold = anim.frameFn(anim.frame);
+    if (hold == ANIM_DONE) {
+        finishAnimation();
+        return anim.running;
+    }
+
+    anim.frame++;
+    anim.nextFrameAt = now + (speed ? (uint32_t)hold * 100 / speed : 0);
+    return true;
+}
+
+/**
+ * @brief Jumps to the end of the running animation
+ *
+ * Remaining frames are dropped and doneFn is called, so the screen ends up
+ * in the same state as if the animation had played to completion.
+ */
+void animationSkip() {
+    if (anim.running) {
+        finishAnimation();
+    }
+}
+
+/**
+ * @brief Stops the running animation without calling its doneFn
+ */
+void animationCancel() {
+    anim.running = false;
+    anim.doneFn = nullptr;
+}
+
+bool animationRunning() { return anim.running; }
+
+bool animationModal() { return anim.running && anim.modal; }
+
+/**
+ * @brief Sets the playback speed, in percent of the normal one
+ *
+ * 0 turns animations off. One still running then ends like a skip, so its
+ * doneFn draws the final state.
+ */
+void animationSetSpeed(uint8_t percent) {
+    speed = percent;
+    if (speed == 0 && anim.running) {
+        finishAnimation();
+    }
+}
@@ -0,0 +1,25 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+
+// Draws frame `frame` of an animation and returns how long (ms) it should
+// stay on screen, or ANIM_DONE once the animation has no frames left.
+typedef uint16_t (*AnimFrameFn)(uint16_t frame);
+typedef void (*AnimDoneFn)();
+
+constexpr uint16_t ANIM_DONE = 0;
+
+void animationStart(AnimFrameFn frameFn, AnimDoneFn doneFn = nullptr,
+                    bool modal = true);
+bool animationTick();
+void animationSkip();
+void animationCancel();
+bool animationRunning();
+bool animationModal();
+
+// percent of the normal speed, 0 turns animations off: they end (and call
+// doneFn) as soon as they are started
+void animationSetSpeed(uint8_t percent);
+
+#endif
@@ -0,0 +1,85 @@
+#include <Arduino.h>
+
+#include "debug/profile.h"
+#include "slide.h"
+#include "ui.h"
+
+static uint8_t outgoing[SCREEN_WIDTH * SLIDE_MAX_PAGES];
+static uint8_t incoming[SCREEN_WIDTH * SLIDE_MAX_PAGES];
+static uint8_t bandPage = 0;
+static uint8_t bandPages = 0;
+
+// draws into the band of the display buffer and keeps a copy of it
+static void capture(void (*draw)(), uint8_t *copy) {
+    uint8_t *band = display.getBuffer() + bandPage * SCREEN_WIDTH;
+    size_t size = bandPages * SCREEN_WIDTH;
+
+    memset(band, 0, size);
+    draw();
+    memcpy(copy, band, size);
+}
+
+// one page row of `src` moved `dx` columns, what falls off is dropped
+static void blitColumns(uint8_t *dst, const uint8_t *src, int dx) {
+    if (dx >= SCREEN_WIDTH || dx <= -SCREEN_WIDTH) {
+        return;
+    }
+    if (dx >= 0) {
+        memcpy(dst + dx, src, SCREEN_WIDTH - dx);
+    } else {
+        memcpy(dst, src - dx, SCREEN_WIDTH + dx);
+    }
+}
+
+/**
+ * @brief Renders both ends of a slide, once per slide
+ *
+ * The draw functions draw at their resting position. They use the display
+ * buffer as scratch space, so only the band is meaningful afterwards and
+ * whatever surrounds it has to be drawn after this call.
+ *
+ * @param firstPage first page of the band, 8 rows each
+ * @param pages     band height in pages, at most SLIDE_MAX_PAGES (more are
+ *                  cut off at the bottom)
+ */
+void slideCapture(uint8_t firstPage, uint8_t pages, void (*drawOutgoing)(),
+                  void (*drawIncoming)()) {
+    bandPage = firstPage;
+    bandPages = min(pages, SLIDE_MAX_PAGES);
+    capture(drawOutgoing, outgoing);
+    capture(drawIncoming, incoming);
+}
+
+/**
+ * @brief Composes frame `frame` of the slide into the band
+ *
+ * Frame 0 shows the outgoing rendering in place, the last one the incoming
+ * rendering, SLIDE_STEP px further each frame. The rest of the buffer is
+ * left alone.
+ *
+ * @param slideRight content moves right, the incoming side enters from the
+ *                   left
+ * @return false once past the last frame, nothing is drawn then
+ *
+ * @note Does not flush the display
+ */
+bool slideCompose(uint16_t frame, bool slideRight) {
+    int offset = frame * SLIDE_STEP;
+    if (offset > SCREEN_WIDTH) {
+        return false;
+    }
+
+    profileBegin(PROFILE_RENDER);
+
+    // the two sides are a screen width apart and never overlap
+    int incomingX = slideRight ? offset - SCREEN_WIDTH : SCREEN_WIDTH - offset;
+    int outgoingX = slideRight ? offset : -offset;
+
+    for (uint8_t page = 0; page < bandPages; page++) {
+        uint8_t *row = display.getBuffer() + (bandPage + page) * SCREEN_WIDTH;
+        memset(row, 0, SCREEN_WIDTH);
+        blitColumns(row, incoming + page * SCREEN_WIDTH, incomingX);
+        blitColumns(row, outgoing + page * SCREEN_WIDTH, outgoingX);
+    }
+    return true;
+}
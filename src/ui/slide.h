@@ -0,0 +1,19 @@
+#ifndef SLIDE_H
+#define SLIDE_H
+
+#include <stdint.h>
+
+// Horizontal slide between two renderings of a band of pages. Both are
+// drawn once by slideCapture() into off-screen page buffers; every frame
+// after that is a memset() and two memcpy()s per page, whatever the band
+// shows. Moving sideways is whole column bytes in the SH1106 layout, no
+// bit shifting involved.
+constexpr int SLIDE_STEP = 16;             // px per frame
+constexpr uint16_t SLIDE_FRAME_TIME = 20; // ms per frame
+constexpr uint8_t SLIDE_MAX_PAGES = 3;    // tallest band, sizes the buffers
+
+void slideCapture(uint8_t firstPage, uint8_t pages, void (*drawOutgoing)(),
+                  void (*drawIncoming)());
+bool slideCompose(uint16_t frame, bool slideRight);
+
+#endif
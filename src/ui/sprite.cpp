@@ -0,0 +1,51 @@
+#include <Arduino.h>
+#include <string.h>
+
+#include "sprite.h"
+#include "ui.h"
+
+/**
+ * @brief Decodes one sprite frame straight into the display buffer
+ *
+ * The frame's rect is overwritten (black pixels included), the rest of the
+ * buffer is left alone. Frames are PackBits encoded: a control byte
+ * n < 128 is followed by n + 1 literal bytes, n >= 128 by one byte repeated
+ * n - 125 times. Runs become memset()s, literals memcpy_P()s, one page row
+ * at a time.
+ *
+ * @note Does not flush the display
+ */
+void drawSprite(const SpriteSheet &sheet, uint8_t frame) {
+    if (frame >= sheet.frames) {
+        return;
+    }
+
+    const uint8_t *src = sheet.data + pgm_read_word(&sheet.offsets[frame]);
+    uint8_t *row = display.getBuffer() + sheet.page * SCREEN_WIDTH + sheet.x;
+    uint8_t *end = row + sheet.pages * SCREEN_WIDTH;
+    uint8_t col = 0;
+
+    while (row < end) {
+        uint8_t control = pgm_read_byte(src++);
+        bool run = control >= 128;
+        int count = run ? control - 125 : control + 1;
+        uint8_t value = run ? pgm_read_byte(src++) : 0;
+
+        // a run or literal may wrap onto the next page
+        while (count > 0 && row < end) {
+            int n = min(count, sheet.width - col);
+            if (run) {
+                memset(row + col, value, n);
+            } else {
+                memcpy_P(row + col, src, n);
+                src += n;
+            }
+            count -= n;
+            col += n;
+            if (col == sheet.width) {
+                col = 0;
+                row += SCREEN_WIDTH;
+            }
+        }
+    }
+}
@@ -0,0 +1,21 @@
+#ifndef SPRITE_H
+#define SPRITE_H
+
+#include <stdint.h>
+
+// Pre-rendered animation frames (see scripts/gen_sprites.py). Every frame
+// covers the same page-aligned rect and is stored 1-bpp in display buffer
+// order, RLE compressed.
+struct SpriteSheet {
+    uint8_t x; // left column
+    uint8_t width;
+    uint8_t page; // top page, 8 rows each
+    uint8_t pages;
+    uint8_t frames;
+    const uint16_t *offsets; // PROGMEM, start of each frame in data
+    const uint8_t *data;     // PROGMEM
+};
+
+void drawSprite(const SpriteSheet &sheet, uint8_t frame);
+
+#endif
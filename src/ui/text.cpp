@@ -0,0 +1,202 @@
+#include <Arduino.h>
+
+#include "text.h"
+#include "ui.h"
+
+constexpr uint8_t GLYPH_CACHE_SIZE = 96; // ' '..'~' plus one spare
+constexpr uint8_t LAYOUT_CACHE_SIZE = 16;
+constexpr char ellipsisText[] = "...";
+
+// Advances of the selected GFX font, copied out of its PROGMEM glyph table
+// once by textSetFont(). The built-in font needs no table, every glyph is
+// CLASSIC_ADVANCE wide.
+static const GFXfont *font = nullptr;
+static uint8_t textSize = 1;
+static uint8_t fontFirst = 0;
+static uint8_t fontCount = 0;
+static uint8_t fontHeight = CLASSIC_HEIGHT;
+static uint8_t advances[GLYPH_CACHE_SIZE];
+
+// Widths of PROGMEM strings. Those never change, so the pointer is the key
+// and a label is walked once per font instead of on every frame.
+struct LayoutEntry {
+    const char *text;
+    const GFXfont *font;
+    uint8_t size;
+    uint16_t width;
+};
+
+static LayoutEntry layouts[LAYOUT_CACHE_SIZE];
+static uint8_t nextLayout = 0;
+
+static uint8_t glyphAdvance(char c) {
+    if (!font) {
+        return CLASSIC_ADVANCE * textSize;
+    }
+    // glyphs outside the font are skipped when drawing, so they take no room
+    uint8_t index = (uint8_t)c - fontFirst;
+    return index < fontCount ? advances[index] * textSize : 0;
+}
+
+/**
+ * @brief Selects the font for drawing and measuring
+ *
+ * @param gfx  GFX font, nullptr for the built-in one. Only glyphs from its
+ *             first one on are cached, GLYPH_CACHE_SIZE of them, which
+ *             covers the printable ASCII range of the Adafruit fonts.
+ * @param size text size multiplier, as for setTextSize()
+ */
+void textSetFont(const GFXfont *gfx, uint8_t size) {
+    font = gfx;
+    textSize = size > 0 ? size : 1;
+    display.setFont(gfx);
+    display.setTextSize(textSize);
+
+    if (!gfx) {
+        return;
+    }
+
+    GFXfont header;
+    memcpy_P(&header, gfx, sizeof(header));
+    fontFirst = header.first;
+    fontHeight = header.yAdvance;
+    fontCount = header.last - header.first + 1;
+    if (fontCount > GLYPH_CACHE_SIZE) {
+        fontCount = GLYPH_CACHE_SIZE;
+    }
+    for (uint8_t i = 0; i < fontCount; i++) {
+        advances[i] = pgm_read_byte(&header.glyph[i].xAdvance);
+    }
+}
+
+// distance between two baselines
+uint8_t textHeight() {
+    return (font ? fontHeight : CLASSIC_HEIGHT) * textSize;
+}
+
+uint16_t textWidth(const char *text, size_t length) {
+    uint16_t width = 0;
+    for (size_t i = 0; i < length; i++) {
+        width += glyphAdvance(text[i]);
+    }
+    return width;
+}
+
+uint16_t textWidth(const char *text) {
+    uint16_t width = 0;
+    while (*text) {
+        width += glyphAdvance(*text++);
+    }
+    return width;
+}
+
+/**
+ * @brief Width of a PROGMEM string, served from the layout cache
+ *
+ * Only for strings that never change, the cache is keyed by address.
+ */
+uint16_t textWidth(const __FlashStringHelper *text) {
+    const char *flash = (const char *)text;
+
+    for (const LayoutEntry &entry : layouts) {
+        if (entry.text == flash && entry.font == font &&
+            entry.size == textSize) {
+            return entry.width;
+        }
+    }
+
+    uint16_t width = 0;
+    char c;
+    while ((c = pgm_read_byte(flash++)) != 0) {
+        width += glyphAdvance(c);
+    }
+
+    layouts[nextLayout] = {(const char *)text, font, textSize, width};
+    nextLayout = (nextLayout + 1) % LAYOUT_CACHE_SIZE;
+    return width;
+}
+
+// how many characters from the start of `text` fit into maxWidth
+size_t textFit(const char *text, size_t length, uint16_t maxWidth) {
+    uint16_t width = 0;
+    for (size_t i = 0; i < length; i++) {
+        width += glyphAdvance(text[i]);
+        if (width > maxWidth) {
+            return i;
+        }
+    }
+    return length;
+}
+
+/**
+ * @brief Breaks `text` into lines no wider than maxWidth
+ *
+ * Lines break after the last space that fits, a word longer than a whole
+ * line is broken where it overflows. The space a line breaks at is dropped.
+ *
+ * @return lines filled in, text beyond maxLines lines is left out
+ */
+uint8_t textWrap(const char *text, uint16_t maxWidth, TextSpan *lines,
+                 uint8_t maxLines) {
+    uint8_t count = 0;
+    const char *start = text;
+    const char *space = nullptr; // last space on the current line
+    uint16_t width = 0;          // start up to p
+    uint16_t spaceWidth = 0;     // start up to and including space
+    const char *p = text;
+
+    for (; *p && count < maxLines; p++) {
+        uint8_t advance = glyphAdvance(*p);
+
+        // twice at most: after the last space, then inside the word
+        while (width + advance > maxWidth && p > start && count < maxLines) {
+            if (space) {
+                lines[count++] = {start, (uint8_t)(space - start)};
+                start = space + 1;
+                width -= spaceWidth;
+                space = nullptr;
+            } else {
+                lines[count++] = {start, (uint8_t)(p - start)};
+                start = p;
+                width = 0;
+            }
+        }
+
+        if (*p == ' ') {
+            space = p;
+            spaceWidth = width + advance;
+        }
+        width += advance;
+    }
+
+    if (count < maxLines && p > start) {
+        lines[count++] = {start, (uint8_t)(p - start)};
+    }
+    return count;
+}
+
+/**
+ * @brief Shortens `span` so that it and "..." fit into maxWidth
+ *
+ * @return false when the whole span fits and was left alone
+ */
+bool textEllipsize(TextSpan &span, uint16_t maxWidth) {
+    if (textWidth(span.text, span.length) <= maxWidth) {
+        return false;
+    }
+
+    uint16_t dots = textWidth(ellipsisText);
+    span.length = textFit(span.text, span.length,
+                          maxWidth > dots ? maxWidth - dots : 0);
+    return true;
+}
+
+// prints at the display cursor, with "..." after it when ellipsis is set
+void textPrint(const TextSpan &span, bool ellipsis) {
+    for (uint8_t i = 0; i < span.length; i++) {
+        display.write(span.text[i]);
+    }
+    if (ellipsis) {
+        display.print(ellipsisText);
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef TEXT_H
+#define TEXT_H
+
+#include <Arduino.h>
+#include <gfxfont.h>
+
+// Text measuring and layout without getTextBounds(). Widths come from the
+// advance of each glyph, so every function here is one pass over the text,
+// allocates nothing and hands out spans pointing into the caller's string.
+// The font is chosen with textSetFont(), which also sets it on the display
+// so drawing and measuring can't disagree.
+
+// the built-in 5x7 font: 5 columns and one blank, 7 rows and one blank
+constexpr uint8_t CLASSIC_ADVANCE = 6;
+constexpr uint8_t CLASSIC_HEIGHT = 8;
+
+// a run of characters inside a longer string, not terminated
+struct TextSpan {
+    const char *text;
+    uint8_t length;
+};
+
+// width of a literal in the built-in font, for layout fixed at compile time
+constexpr uint16_t textWidthOf(const char *text, uint8_t size = 1) {
+    uint16_t width = 0;
+    while (*text++) {
+        width += CLASSIC_ADVANCE * size;
+    }
+    return width;
+}
+
+void textSetFont(const GFXfont *gfx = nullptr, uint8_t size = 1);
+uint8_t textHeight();
+uint16_t textWidth(const char *text, size_t length);
+uint16_t textWidth(const char *text);
+uint16_t textWidth(const __FlashStringHelper *text); // cached, see text.cpp
+size_t textFit(const char *text, size_t length, uint16_t maxWidth);
+uint8_t textWrap(const char *text, uint16_t maxWidth, TextSpan *lines,
+                 uint8_t maxLines);
+bool textEllipsize(TextSpan &span, uint16_t maxWidth);
+void textPrint(const TextSpan &span, bool ellipsis = false);
+
+#endif
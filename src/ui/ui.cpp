@@ -2,290 +2,267 @@
 #include <Adafruit_GFX.h>
 #include <Wire.h>
 
+#include "fixmath.h"
+#include "raster.h"
+#include "startup_sprites.h" // generated by scripts/gen_sprites.py
+#include "text.h"
 #include "ui.h"
 
-/**
- * @brief Displays an animated startup sequence featuring a sleeping hamster
- * that wakes up
- *
- * Animation phases:
- * 1. Sleeping hamster with breathing effect and floating "zzz" (frames 0-5)
- * 2. Hamster waking up and stretching with ears popping up (frames 6-11)
- * 3. Happy wiggling hamster with hearts and sparkles (frames 12-21)
- * 4. Sparkle burst effect radiating from center
- * 5. Text "kajdanek :3" reveals letter by letter from center outward
- * 6. Final pulse effect with hearts on both sides of text
- *
- * @note Total animation duration: ~5 seconds
- * @note Uses display.clearDisplay(), display.display() for frame updates
- */
-void startupAnimation() {
-    int centerX = SCREEN_WIDTH / 2;
-    int centerY = SCREEN_HEIGHT / 2;
-
-    // sleeping hamster wakes up
-    for (int frame = 0; frame < 22; frame++) {
-        display.clearDisplay();
-
-        if (frame < 6) {
-            // hamster sleeping - curled up ball
-            int breathe = abs(sin(frame * 1.2)) * 2;
-
-            // body (curled)
-            display.fillCircle(centerX, centerY + breathe, 10, SH110X_WHITE);
-            display.fillCircle(centerX - 3, centerY - 3 + breathe, 6,
-                               SH110X_WHITE);
-
-            // closed eyes zzz
-            display.drawLine(centerX - 2, centerY - 2 + breathe, centerX - 4,
-                             centerY - 2 + breathe, SH110X_BLACK);
-            display.drawLine(centerX + 2, centerY - 2 + breathe, centerX + 4,
-                             centerY - 2 + breathe, SH110X_BLACK);
-
-            // zzz floating up
-            if (frame > 2) {
-                display.setTextSize(1);
-                display.setCursor(centerX + 15, centerY - 12 - frame);
-                display.print("z");
-            }
-
-        } else if (frame < 12) {
-            // waking up - stretching
-            int stretchPhase = frame - 6;
-
-            // body starts uncurling
-            display.fillCircle(centerX, centerY, 9, SH110X_WHITE);
-            display.fillCircle(centerX - 4, centerY - 4, 5, SH110X_WHITE);
-
-            // ears pop up
-            if (stretchPhase > 2) {
-                display.fillCircle(centerX - 7, centerY - 10, 3, SH110X_WHITE);
-                display.fillCircle(centerX - 1, centerY - 11, 3, SH110X_WHITE);
-            }
-
-            // eyes opening
-            if (stretchPhase > 1) {
-                display.drawPixel(centerX - 3, centerY - 3, SH110X_BLACK);
-                display.drawPixel(centerX + 1, centerY - 3, SH110X_BLACK);
-            }
-
-            // little paws stretching out
-            if (stretchPhase > 4) {
-                display.fillCircle(centerX - 12, centerY + 3, 2, SH110X_WHITE);
-                display.fillCircle(centerX + 8, centerY + 3, 2, SH110X_WHITE);
-            }
-
-        } else {
-            // fully awake and happy
-            int wigglePhase = frame - 12;
-            int wiggle = (wigglePhase % 2 == 0) ? 1 : -1;
-
-            // body
-            display.fillCircle(centerX + wiggle, centerY, 9, SH110X_WHITE);
-            display.fillCircle(centerX - 4 + wiggle, centerY - 4, 5,
-                               SH110X_WHITE);
-
-            // ears
-            display.fillCircle(centerX - 7 + wiggle, centerY - 10, 3,
-                               SH110X_WHITE);
-            display.fillCircle(centerX - 1 + wiggle, centerY - 11, 3,
-                               SH110X_WHITE);
-
-            // happy eyes (^_^)
-            display.drawLine(centerX - 4 + wiggle, centerY - 3,
-                             centerX - 2 + wiggle, centerY - 3, SH110X_BLACK);
-            display.drawLine(centerX + wiggle, centerY - 3,
-                             centerX + 2 + wiggle, centerY - 3, SH110X_BLACK);
+constexpr char startupText[] = "kajdanek :3";
+constexpr int HEADER_TITLE_X = 7;
 
-            // nose
-            display.drawPixel(centerX - 1 + wiggle, centerY - 1, SH110X_BLACK);
+constexpr uint16_t STARTUP_HAMSTER_FRAMES = hamsterSheet.frames;
+constexpr uint16_t STARTUP_BURST_FRAMES = burstSheet.frames;
+constexpr uint16_t STARTUP_REVEAL_FRAMES = (sizeof(startupText) - 1) / 2 + 1;
+constexpr uint16_t STARTUP_PULSE_FRAMES = 3;
 
-            // paws
-            display.fillCircle(centerX - 10 + wiggle, centerY + 5, 2,
-                               SH110X_WHITE);
-            display.fillCircle(centerX + 6 + wiggle, centerY + 5, 2,
-                               SH110X_WHITE);
-
-            // cheeks
-            display.fillCircle(centerX - 8 + wiggle, centerY, 3, SH110X_WHITE);
-            display.fillCircle(centerX + 4 + wiggle, centerY, 3, SH110X_WHITE);
-
-            // hearts appear
-            if (wigglePhase > 4) {
-                display.drawBitmap(centerX - 25, centerY - 8, heartBitmap, 8, 8,
-                                   SH110X_WHITE);
-                display.drawBitmap(centerX + 15, centerY - 8, heartBitmap, 8, 8,
-                                   SH110X_WHITE);
-            }
+// Hamster frames are pre-rendered sprites, only the font-drawn "zzz" of
+// the sleeping frames is added at runtime
+static void drawStartupHamster(int frame) {
+    drawSprite(hamsterSheet, frame);
 
-            // sparkle effect
-            if (wigglePhase > 6) {
-                display.drawPixel(centerX - 20, centerY - 15, SH110X_WHITE);
-                display.drawPixel(centerX + 18, centerY - 15, SH110X_WHITE);
-                display.drawPixel(centerX, centerY - 20, SH110X_WHITE);
-            }
-        }
+    // zzz floating up
+    if (frame > 2 && frame < 6) {
+        int centerX = SCREEN_WIDTH / 2;
+        int centerY = SCREEN_HEIGHT / 2;
 
-        display.display();
-        delay(frame < 6 ? 200 : (frame < 12 ? 120 : 100));
+        display.setTextSize(1);
+        display.setCursor(centerX + 15, centerY - 12 - frame);
+        display.print("z");
     }
+}
 
-    delay(300);
-
-    // text reveals letter by letter from center outward
-    const char *text = "kajdanek :3";
-    int textLen = strlen(text);
-    int16_t x1, y1;
-    uint16_t w, h;
+// letters appear from center outward with pop effect, the last reveal step
+// (and every step after it) shows the whole text
+static void drawStartupText(int reveal, bool hearts) {
+    constexpr int textLen = sizeof(startupText) - 1;
+    constexpr int w = textWidthOf(startupText);
+    constexpr int textX = (SCREEN_WIDTH - w) / 2;
     display.setTextSize(1);
-    display.getTextBounds(text, 0, 0, &x1, &y1, &w, &h);
-    int textX = (SCREEN_WIDTH - w) / 2;
-    int textY = centerY - 4;
+    int textY = SCREEN_HEIGHT / 2 - 4;
 
-    // sparkle burst before text
-    for (int burst = 0; burst < 8; burst++) {
-        display.clearDisplay();
-
-        for (int i = 0; i < 12; i++) {
-            float angle = (i * 30) * (PI / 180.0);
-            int dist = burst * 8;
-            int px = centerX + cos(angle) * dist;
-            int py = centerY + sin(angle) * dist;
-
-            if (px >= 0 && px < SCREEN_WIDTH && py >= 0 && py < SCREEN_HEIGHT) {
-                display.fillCircle(px, py, 1, SH110X_WHITE);
-            }
+    int centerChar = textLen / 2;
+    int bounce = (reveal == 0 || reveal > centerChar) ? 0 : 2;
+
+    for (int i = 0; i < textLen; i++) {
+        int distFromCenter = abs(i - centerChar);
+        if (distFromCenter <= reveal) {
+            int charX = textX + i * CLASSIC_ADVANCE;
+            int charY = (distFromCenter == reveal) ? textY - bounce : textY;
+            display.setCursor(charX, charY);
+            display.print(startupText[i]);
         }
+    }
 
-        display.display();
-        delay(35);
+    if (hearts) {
+        display.drawBitmap(textX - 12, textY, heartBitmap, 8, 8, SH110X_WHITE);
+        display.drawBitmap(textX + w + 4, textY, heartBitmap, 8, 8,
+                           SH110X_WHITE);
     }
+}
 
-    // letters appear from center outward with pop effect
-    int centerChar = textLen / 2;
-    for (int reveal = 0; reveal <= centerChar; reveal++) {
-        display.clearDisplay();
+static uint16_t startupFrame(uint16_t frame) {
+    display.clearDisplay();
 
-        // draw revealed characters with bounce
-        int bounce = (reveal == 0) ? 0 : 2;
+    // sleeping hamster wakes up
+    if (frame < STARTUP_HAMSTER_FRAMES) {
+        drawStartupHamster(frame);
+        display.present();
 
-        for (int i = 0; i < textLen; i++) {
-            int distFromCenter = abs(i - centerChar);
-            if (distFromCenter <= reveal) {
-                int charX = textX + i * 6;
-                int charY = (distFromCenter == reveal) ? textY - bounce : textY;
-                display.setCursor(charX, charY);
-                display.print(text[i]);
-            }
+        // short pause on the last frame before the burst
+        if (frame == STARTUP_HAMSTER_FRAMES - 1) {
+            return 100 + 300;
         }
+        return frame < 6 ? 200 : (frame < 12 ? 120 : 100);
+    }
+    frame -= STARTUP_HAMSTER_FRAMES;
 
-        // hearts pop in with text
-        if (reveal > centerChar - 2) {
-            display.drawBitmap(textX - 12, textY, heartBitmap, 8, 8,
-                               SH110X_WHITE);
-            display.drawBitmap(textX + w + 4, textY, heartBitmap, 8, 8,
-                               SH110X_WHITE);
-        }
+    // sparkle burst before text
+    if (frame < STARTUP_BURST_FRAMES) {
+        drawSprite(burstSheet, frame);
+        display.present();
+        return 35;
+    }
+    frame -= STARTUP_BURST_FRAMES;
 
-        display.display();
-        delay(80);
+    // text reveal, hearts pop in with the last two steps
+    if (frame < STARTUP_REVEAL_FRAMES) {
+        drawStartupText(frame, frame > STARTUP_REVEAL_FRAMES - 3);
+        display.present();
+        return 80;
     }
+    frame -= STARTUP_REVEAL_FRAMES;
 
     // final pulse effect
-    for (int pulse = 0; pulse < 3; pulse++) {
-        display.clearDisplay();
-
-        if (pulse % 2 == 0) {
-            display.setCursor(textX, textY);
-            display.print(text);
-            display.drawBitmap(textX - 12, textY, heartBitmap, 8, 8,
-                               SH110X_WHITE);
-            display.drawBitmap(textX + w + 4, textY, heartBitmap, 8, 8,
-                               SH110X_WHITE);
+    if (frame < STARTUP_PULSE_FRAMES) {
+        if (frame % 2 == 0) {
+            drawStartupText(STARTUP_REVEAL_FRAMES, true);
         }
-
-        display.display();
-        delay(150);
+        display.present();
+        return 150;
     }
+    frame -= STARTUP_PULSE_FRAMES;
 
-    // final display
-    display.clearDisplay();
-    display.setCursor(textX, textY);
-    display.print(text);
-    display.drawBitmap(textX - 12, textY, heartBitmap, 8, 8, SH110X_WHITE);
-    display.drawBitmap(textX + w + 4, textY, heartBitmap, 8, 8, SH110X_WHITE);
-    display.display();
+    // final display, then blank
+    if (frame == 0) {
+        drawStartupText(STARTUP_REVEAL_FRAMES, true);
+        display.present();
+        return 500;
+    }
+    if (frame == 1) {
+        display.present();
+        return 1;
+    }
+    return ANIM_DONE;
+}
 
-    delay(500);
-    display.clearDisplay();
-    display.display();
+/**
+ * @brief Displays an animated startup sequence featuring a sleeping hamster
+ * that wakes up
+ *
+ * Animation phases:
+ * 1. Sleeping hamster with breathing effect and floating "zzz" (frames 0-5)
+ * 2. Hamster waking up and stretching with ears popping up (frames 6-11)
+ * 3. Happy wiggling hamster with hearts and sparkles (frames 12-21)
+ * 4. Sparkle burst effect radiating from center
+ * 5. Text "kajdanek :3" reveals letter by letter from center outward
+ * 6. Final pulse effect with hearts on both sides of text
+ *
+ * @param onDone Called when the sequence ends or is skipped
+ *
+ * @note Total animation duration: ~5 seconds
+ * @note Non-blocking, played by the frame scheduler as a modal animation
+ * @note Hamster and burst frames are sprites pre-rendered at build time by
+ *       scripts/gen_sprites.py, only text is drawn at runtime
+ */
+void startupAnimation(AnimDoneFn onDone) {
+    animationStart(startupFrame, onDone, true);
 }
 
 /**
- * @brief Displays a scanning/loading animation with progress indication
+ * @brief Draws one frame of the scanning screen with real progress
  *
  * Shows "SKANUJE" header with percentage counter (0-100%)
  * Features:
  * - Three bouncing dots animation in center
  * - Progress bar with decorative corner accents
- * - Success screen at completion showing "Koniec! (^_^)"
  *
- * Animation details:
- * - 15 frames for scan phase (~1.8 seconds)
- * - Each frame updates percentage and progress bar
- * - Dots bounce with sine wave pattern
+ * @param percent Scan progress, 0-100
+ * @param frame Animation frame for the bouncing dots, advanced by the caller
+ *              (~120ms per frame looks right)
  *
- * @note Total duration: ~2.3 seconds including success screen
+ * @note Does not clear or flush the display
  */
-void scanAnimation() {
-    for (int frame = 0; frame < 15; frame++) {
-        display.clearDisplay();
-
-        drawHeader("SKANUJE");
-        display.setCursor(SCREEN_WIDTH - 30, 0);
-        display.print((frame * 100) / 15);
-        display.print("%");
-
-        // drawDecorativeLine();
+void drawScanProgress(int percent, uint16_t frame) {
+    drawHeader("SKANUJE");
+    display.setCursor(SCREEN_WIDTH - 30, 0);
+    display.print(percent);
+    display.print("%");
+
+    // drawDecorativeLine();
+
+    // bouncing dots
+    int dotSpacing = 12;
+    int startX = 52;
+    int baseY = 30;
+
+    for (int i = 0; i < 3; i++) {
+        int jumpHeight = fixBounce((frame + i * 2) * 34, 8); // 0.6 rad/frame
+        display.fillCircle(startX + (i * dotSpacing), baseY - jumpHeight, 3,
+                           SH110X_WHITE);
+    }
 
-        // bouncing dots
-        int dotSpacing = 12;
-        int startX = 52;
-        int baseY = 30;
+    // progress bar
+    int barWidth = (percent * 106) / 100;
+    rasterRect(10, 48, 108, 10, SH110X_WHITE);
 
-        for (int i = 0; i < 3; i++) {
-            float jumpPhase = (frame + i * 2) * 0.6;
-            int jumpHeight = abs(sin(jumpPhase)) * 8;
-            display.fillCircle(startX + (i * dotSpacing), baseY - jumpHeight, 3,
-                               SH110X_WHITE);
-        }
+    // corner accents
+    drawSelectionBox(10, 48, 108, 10);
+    rasterFillRect(11, 49, barWidth, 8, SH110X_WHITE);
+}
 
-        // progress bar
-        int barWidth = (frame * 106) / 15;
-        display.drawRect(10, 48, 108, 10, SH110X_WHITE);
+constexpr uint16_t SUBMENU_ENTER_FRAMES = 12;
 
-        // corner accents
-        drawSelectionBox(10, 48, 108, 10);
-        display.fillRect(11, 49, barWidth, 8, SH110X_WHITE);
+static uint16_t submenuEnterFrame(uint16_t frame) {
+    const Vec2 center = {SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2};
+    int centerX = center.x;
+    int centerY = center.y;
 
-        display.display();
-        delay(120);
+    // flash effect
+    if (frame == SUBMENU_ENTER_FRAMES) {
+        rasterFillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, SH110X_WHITE);
+        display.present();
+        return 50;
+    }
+    if (frame == SUBMENU_ENTER_FRAMES + 1) {
+        display.clearDisplay();
+        display.present();
+        return 30;
+    }
+    if (frame > SUBMENU_ENTER_FRAMES + 1) {
+        return ANIM_DONE;
     }
 
-    // success screen
+    // explosive zoom + particles
     display.clearDisplay();
-    drawHeader("SUKCES");
-    drawDecorativeLine();
 
-    display.setCursor(38, 28);
-    display.print("Koniec!");
-    display.setCursor(42, 42);
-    display.print("(^_^)");
+    // expanding circle ripples
+    int rippleRadius = frame * 12;
+    if (rippleRadius < SCREEN_WIDTH) {
+        display.drawCircle(centerX, centerY, rippleRadius, SH110X_WHITE);
+        if (frame > 2) {
+            display.drawCircle(centerX, centerY, rippleRadius - 8,
+                               SH110X_WHITE);
+        }
+    }
 
-    drawSelectionBox(35, 40, 52, 12);
+    // corner brackets explode outward
+    int cornerDist = frame * 8;
+    int cornerSize = 6;
+
+    // each arm is cornerSize + 1 pixels, corner included
+    int left = cornerDist;
+    int right = SCREEN_WIDTH - cornerDist;
+    int top = cornerDist;
+    int bottom = SCREEN_HEIGHT - cornerDist;
+    int arm = cornerSize + 1;
+
+    // top-left
+    rasterHLine(left, top, arm, SH110X_WHITE);
+    rasterVLine(left, top, arm, SH110X_WHITE);
+
+    // top-right
+    rasterHLine(right - cornerSize, top, arm, SH110X_WHITE);
+    rasterVLine(right, top, arm, SH110X_WHITE);
+
+    // bottom-left
+    rasterHLine(left, bottom, arm, SH110X_WHITE);
+    rasterVLine(left, bottom - cornerSize, arm, SH110X_WHITE);
+
+    // bottom-right
+    rasterHLine(right - cornerSize, bottom, arm, SH110X_WHITE);
+    rasterVLine(right, bottom - cornerSize, arm, SH110X_WHITE);
+
+    // particle burst
+    for (int i = 0; i < 8; i++) {
+        int particleDist = frame * 6;
+        Vec2 p = fixPolar(center, i * 45, particleDist);
+
+        if (p.x >= 0 && p.x < SCREEN_WIDTH && p.y >= 0 && p.y < SCREEN_HEIGHT) {
+            display.fillCircle(p.x, p.y, 2, SH110X_WHITE);
+            // trailing particles
+            if (frame > 3) {
+                Vec2 t = fixPolar(center, i * 45, particleDist - 12);
+                if (t.x >= 0 && t.x < SCREEN_WIDTH && t.y >= 0 &&
+                    t.y < SCREEN_HEIGHT) {
+                    display.drawPixel(t.x, t.y, SH110X_WHITE);
+                }
+            }
+        }
+    }
 
-    display.display();
-    delay(500);
+    display.present();
+    return 40;
 }
 
 /**
@@ -303,92 +280,13 @@ void scanAnimation() {
  * 2. Frame particles appear after frame 3 for trailing effect
  * 3. White screen flash (50ms) followed by black flash (30ms)
  *
+ * @param onDone Called when the transition ends or is skipped
+ *
  * @note Duration: ~0.6 seconds total
- * @note Uses trigonometric calculations for particle positioning
+ * @note Particle positions come from the fixed-point sine table
  */
-void submenuEnterAnimation() {
-    int centerX = SCREEN_WIDTH / 2;
-    int centerY = SCREEN_HEIGHT / 2;
-
-    // explosive zoom + particles
-    for (int frame = 0; frame < 12; frame++) {
-        display.clearDisplay();
-
-        // expanding circle ripples
-        int rippleRadius = frame * 12;
-        if (rippleRadius < SCREEN_WIDTH) {
-            display.drawCircle(centerX, centerY, rippleRadius, SH110X_WHITE);
-            if (frame > 2) {
-                display.drawCircle(centerX, centerY, rippleRadius - 8,
-                                   SH110X_WHITE);
-            }
-        }
-
-        // corner brackets explode outward
-        int cornerDist = frame * 8;
-        int cornerSize = 6;
-
-        // top-left
-        display.drawLine(cornerDist, cornerDist, cornerDist + cornerSize,
-                         cornerDist, SH110X_WHITE);
-        display.drawLine(cornerDist, cornerDist, cornerDist,
-                         cornerDist + cornerSize, SH110X_WHITE);
-
-        // top-right
-        display.drawLine(SCREEN_WIDTH - cornerDist, cornerDist,
-                         SCREEN_WIDTH - cornerDist - cornerSize, cornerDist,
-                         SH110X_WHITE);
-        display.drawLine(SCREEN_WIDTH - cornerDist, cornerDist,
-                         SCREEN_WIDTH - cornerDist, cornerDist + cornerSize,
-                         SH110X_WHITE);
-
-        // bottom-left
-        display.drawLine(cornerDist, SCREEN_HEIGHT - cornerDist,
-                         cornerDist + cornerSize, SCREEN_HEIGHT - cornerDist,
-                         SH110X_WHITE);
-        display.drawLine(cornerDist, SCREEN_HEIGHT - cornerDist, cornerDist,
-                         SCREEN_HEIGHT - cornerDist - cornerSize, SH110X_WHITE);
-
-        // bottom-right
-        display.drawLine(SCREEN_WIDTH - cornerDist, SCREEN_HEIGHT - cornerDist,
-                         SCREEN_WIDTH - cornerDist - cornerSize,
-                         SCREEN_HEIGHT - cornerDist, SH110X_WHITE);
-        display.drawLine(SCREEN_WIDTH - cornerDist, SCREEN_HEIGHT - cornerDist,
-                         SCREEN_WIDTH - cornerDist,
-                         SCREEN_HEIGHT - cornerDist - cornerSize, SH110X_WHITE);
-
-        // particle burst
-        for (int i = 0; i < 8; i++) {
-            float angle = (i * 45) * (PI / 180.0);
-            int particleDist = frame * 6;
-            int px = centerX + cos(angle) * particleDist;
-            int py = centerY + sin(angle) * particleDist;
-
-            if (px >= 0 && px < SCREEN_WIDTH && py >= 0 && py < SCREEN_HEIGHT) {
-                display.fillCircle(px, py, 2, SH110X_WHITE);
-                // trailing particles
-                if (frame > 3) {
-                    int px2 = centerX + cos(angle) * (particleDist - 12);
-                    int py2 = centerY + sin(angle) * (particleDist - 12);
-                    if (px2 >= 0 && px2 < SCREEN_WIDTH && py2 >= 0 &&
-                        py2 < SCREEN_HEIGHT) {
-                        display.drawPixel(px2, py2, SH110X_WHITE);
-                    }
-                }
-            }
-        }
-
-        display.display();
-        delay(40);
-    }
-
-    // flash effect
-    display.fillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, SH110X_WHITE);
-    display.display();
-    delay(50);
-    display.clearDisplay();
-    display.display();
-    delay(30);
+void submenuEnterAnimation(AnimDoneFn onDone) {
+    animationStart(submenuEnterFrame, onDone, true);
 }
 
 // ===== UI COMPONENTS =====
@@ -405,19 +303,27 @@ void submenuEnterAnimation() {
  * @note Text size is set to 1
  * @note Counter appears right-aligned when both current >= 0 and total > 0
  * @note Counter format: "<1/5>" shows current page 1 of 5 total pages
+ * @note A title too long for the space left is shortened with "..."
  *
  * @example drawHeader("MENU", 2, 5); // Shows "[MENU]      <2/5>"
  * @example drawHeader("SETTINGS", -1, 0); // Shows "[SETTINGS]" only
  */
 void drawHeader(const char *title, int current, int total) {
+    bool counter = current >= 0 && total > 0;
+
     display.setTextSize(1);
     display.setCursor(0, 0);
     display.print(F("["));
-    display.setCursor(7, 0);
-    display.print(title);
+
+    // long SSIDs end in "..." instead of running under the counter
+    TextSpan span = {title, (uint8_t)strlen(title)};
+    int room = (counter ? SCREEN_WIDTH - 34 : SCREEN_WIDTH) - HEADER_TITLE_X;
+    bool cut = textEllipsize(span, room);
+    display.setCursor(HEADER_TITLE_X, 0);
+    textPrint(span, cut);
 
     // counter if provided
-    if (current >= 0 && total > 0) {
+    if (counter) {
         display.setCursor(SCREEN_WIDTH - 32, 0);
         display.print("<");
         display.print(current);
@@ -427,6 +333,13 @@ void drawHeader(const char *title, int current, int total) {
     }
 }
 
+// same header with a PROGMEM title, used for menu tree labels
+void drawHeader(const __FlashStringHelper *title, int current, int total) {
+    drawHeader("", current, total);
+    display.setCursor(HEADER_TITLE_X, 0);
+    display.print(title);
+}
+
 /**
  * @brief Draws decorative horizontal lines beneath the header
  *
@@ -447,12 +360,12 @@ void drawHeader(const char *title, int current, int total) {
  * @note Fixed position below header (y: 10-14)
  */
 void drawDecorativeLine() {
-    display.drawLine(0, 11, SCREEN_WIDTH, 11, SH110X_WHITE);
-    display.drawLine(0, 13, SCREEN_WIDTH, 13, SH110X_WHITE);
-    display.drawLine(0, 10, 5, 10, SH110X_WHITE);
-    display.drawLine(SCREEN_WIDTH - 5, 10, SCREEN_WIDTH, 10, SH110X_WHITE);
-    display.drawLine(0, 14, 5, 14, SH110X_WHITE);
-    display.drawLine(SCREEN_WIDTH - 5, 14, SCREEN_WIDTH, 14, SH110X_WHITE);
+    rasterHLine(0, 11, SCREEN_WIDTH, SH110X_WHITE);
+    rasterHLine(0, 13, SCREEN_WIDTH, SH110X_WHITE);
+    rasterHLine(0, 10, 6, SH110X_WHITE);
+    rasterHLine(SCREEN_WIDTH - 5, 10, 5, SH110X_WHITE);
+    rasterHLine(0, 14, 6, SH110X_WHITE);
+    rasterHLine(SCREEN_WIDTH - 5, 14, 5, SH110X_WHITE);
 }
 
 /**
@@ -512,65 +425,13 @@ void drawNavigationDots() {
  * @note Also used in progress bars and UI elements
  */
 void drawSelectionBox(int x, int y, int w, int h) {
-    // corner brackets only
-    display.drawLine(x, y, x + 5, y, SH110X_WHITE);
-    display.drawLine(x, y, x, y + 5, SH110X_WHITE);
-    display.drawLine(x + w - 5, y, x + w, y, SH110X_WHITE);
-    display.drawLine(x + w, y, x + w, y + 5, SH110X_WHITE);
-    display.drawLine(x, y + h - 5, x, y + h, SH110X_WHITE);
-    display.drawLine(x, y + h, x + 5, y + h, SH110X_WHITE);
-    display.drawLine(x + w, y + h - 5, x + w, y + h, SH110X_WHITE);
-    display.drawLine(x + w - 5, y + h, x + w, y + h, SH110X_WHITE);
-}
-
-/**
- * @brief Generic horizontal slide transition animation between screens
- *
- * Smoothly animates transition by sliding current content in while
- * sliding previous content out. Supports bidirectional sliding.
- *
- * @param drawCurrent Function pointer to draw the incoming screen content.
- *                    Receives x-offset parameter for positioning during slide
- * @param drawPrevious Function pointer to draw the outgoing screen content.
- *                     Receives x-offset parameter for positioning during slide
- * @param current Current screen/menu index (passed to drawCurrent)
- * @param previous Previous screen/menu index (passed to drawPrevious)
- * @param slideRight Direction of slide: true = slide right (prev -> current
- * moves left to right) false = slide left (prev -> current moves right to left)
- *
- * Animation details:
- * - Moves in 16-pixel increments for smooth 60fps-style animation
- * - Takes ~20ms per frame (SCREEN_WIDTH/16 frames total)
- * - Both screens are visible during transition for seamless effect
- *
- * @note Drawing functions must handle x-offset positioning
- * @note Total animation time: ~160ms for 128px width screen
- *
- * @example
- * // Slide from menu item 1 to item 2 (rightward)
- * slideAnimation(drawMenuItem, drawMenuItem, 2, 1, true);
- */
-void slideAnimation(void (*drawCurrent)(int), void (*drawPrevious)(int),
-                    int current, int previous, bool slideRight) {
-    for (int offset = 0; offset <= SCREEN_WIDTH; offset += 16) {
-        display.clearDisplay();
-
-        // current slides in
-        int currentX =
-            slideRight ? (-SCREEN_WIDTH + offset) : (SCREEN_WIDTH - offset);
-        if (currentX > -SCREEN_WIDTH && currentX < SCREEN_WIDTH) {
-            display.setCursor(currentX, 0);
-            drawCurrent(currentX);
-        }
-
-        // previous slides out
-        int prevX = slideRight ? offset : -offset;
-        if (prevX > -SCREEN_WIDTH && prevX < SCREEN_WIDTH) {
-            display.setCursor(prevX, 0);
-            drawPrevious(prevX);
-        }
-
-        display.display();
-        delay(20);
-    }
+    // corner brackets only, 6 pixels per arm
+    rasterHLine(x, y, 6, SH110X_WHITE);
+    rasterVLine(x, y, 6, SH110X_WHITE);
+    rasterHLine(x + w - 5, y, 6, SH110X_WHITE);
+    rasterVLine(x + w, y, 6, SH110X_WHITE);
+    rasterVLine(x, y + h - 5, 6, SH110X_WHITE);
+    rasterHLine(x, y + h, 6, SH110X_WHITE);
+    rasterVLine(x + w, y + h - 5, 6, SH110X_WHITE);
+    rasterHLine(x + w - 5, y + h, 6, SH110X_WHITE);
 }
@@ -1,18 +1,19 @@
 #ifndef UI_H
 #define UI_H
 
-#include <Adafruit_SH110X.h>
+#include "display/oled.h"
+#include "scheduler.h"
 
-extern Adafruit_SH1106G display;
+extern OledDisplay display;
 
 void drawHeader(const char *title, int current = -1, int total = -1);
+void drawHeader(const __FlashStringHelper *title, int current = -1,
+                int total = -1);
 void drawDecorativeLine();
 void drawNavigationDots();
 void drawSelectionBox(int x, int y, int w, int h);
-void slideAnimation(void (*drawCurrent)(int), void (*drawPrevious)(int),
-                    int current, int previous, bool slideRight);
-void scanAnimation();
-void startupAnimation();
-void submenuEnterAnimation();
+void drawScanProgress(int percent, uint16_t frame);
+void startupAnimation(AnimDoneFn onDone = nullptr);
+void submenuEnterAnimation(AnimDoneFn onDone = nullptr);
 
 #endif
@@ -0,0 +1,18 @@
+#ifndef VIEW_H
+#define VIEW_H
+
+#include <stdint.h>
+
+// Retained screen state. Anything that changes what a screen shows bumps
+// `version`; the screen is redrawn and flushed only when that differs from
+// the version that was last drawn.
+struct View {
+    uint16_t version = 1;
+    uint16_t drawnVersion = 0;
+
+    void invalidate() { version++; }
+    bool needsRedraw() const { return version != drawnVersion; }
+    void markDrawn() { drawnVersion = version; }
+};
+
+#endif
@@ -0,0 +1,77 @@
+#include <ESP8266WiFi.h>
+#include <string.h>
+
+#include "netview.h"
+
+static bool passesFilter(const NetworkView &view, const NetworkTable &table,
+                         uint8_t row) {
+    if (!view.showHidden && table.hidden[row]) {
+        return false;
+    }
+
+    bool open = table.encryption[row] == ENC_TYPE_NONE;
+    switch (view.filter) {
+    case FILTER_OPEN:
+        return open;
+    case FILTER_SECURED:
+        return !open;
+    default:
+        return true;
+    }
+}
+
+// true when row a belongs before row b
+static bool sortsBefore(const NetworkView &view, const NetworkTable &table,
+                        uint8_t a, uint8_t b) {
+    switch (view.sort) {
+    case SORT_SSID:
+        return strcasecmp(table.ssid[a], table.ssid[b]) < 0;
+    case SORT_CHANNEL:
+        if (table.channel[a] != table.channel[b]) {
+            return table.channel[a] < table.channel[b];
+        }
+        return table.rssi[a] > table.rssi[b];
+    default:
+        return table.rssi[a] > table.rssi[b];
+    }
+}
+
+/**
+ * @brief Rebuilds the row permutation for the current sort and filters
+ *
+ * Filtered rows are collected in table order and then insertion sorted.
+ * With at most SCAN_MAX_NETWORKS entries that beats anything fancier and
+ * keeps equal keys in scan order, so rows don't jump around on rebuilds.
+ *
+ * @note Only moves one-byte indices, table entries are never copied
+ */
+void networkViewBuild(NetworkView &view, const NetworkTable &table) {
+    view.count = 0;
+
+    for (uint8_t row = 0; row < table.count; row++) {
+        if (!passesFilter(view, table, row)) {
+            continue;
+        }
+
+        uint8_t pos = view.count++;
+        while (pos > 0 && sortsBefore(view, table, row, view.order[pos - 1])) {
+            view.order[pos] = view.order[pos - 1];
+            pos--;
+        }
+        view.order[pos] = row;
+    }
+}
+
+/**
+ * @brief Finds the list position of a table row
+ *
+ * @return Position in view.order, or -1 if the row is filtered out
+ */
+int networkViewFind(const NetworkView &view, uint8_t row) {
+    for (int i = 0; i < view.count; i++) {
+        if (view.order[i] == row) {
+            return i;
+        }
+    }
+    return -1;
+}
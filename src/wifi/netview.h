@@ -0,0 +1,30 @@
+#ifndef NETVIEW_H
+#define NETVIEW_H
+
+#include <stdint.h>
+
+#include "scanner.h"
+
+enum SortMode : uint8_t { SORT_RSSI, SORT_SSID, SORT_CHANNEL, SORT_MODES };
+
+enum EncFilter : uint8_t {
+    FILTER_ALL,
+    FILTER_OPEN,
+    FILTER_SECURED,
+    FILTER_MODES
+};
+
+// Sorted, filtered view over the scan table. `order` holds table row
+// indices, the table itself is never copied or reordered.
+struct NetworkView {
+    uint8_t order[SCAN_MAX_NETWORKS];
+    uint8_t count;
+    SortMode sort;
+    EncFilter filter;
+    bool showHidden;
+};
+
+void networkViewBuild(NetworkView &view, const NetworkTable &table);
+int networkViewFind(const NetworkView &view, uint8_t row);
+
+#endif
@@ -0,0 +1,328 @@
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+
+#include "scanner.h"
+
+enum ScanState : uint8_t { SCAN_IDLE, SCAN_RUNNING, SCAN_DONE };
+
+static ScanState state = SCAN_IDLE;
+static uint8_t channel = SCAN_FIRST_CHANNEL;
+static bool monitor = false;
+static unsigned long monitorInterval = SCAN_MONITOR_INTERVAL;
+static bool paused = false;
+static uint32_t sweepStart = 0; // millis() the current sweep began
+static uint32_t sweepEnd = 0;   // millis() the last sweep finished
+static uint16_t sweep = 0;      // bumped by every scannerStart()
+
+// an SDK scan we started and have not collected yet. It can outlive an
+// abort, the SDK has no way to cancel it, and then belongs to an older
+// sweep than the one running when it lands
+static bool inFlight = false;
+static uint16_t inFlightSweep = 0;
+
+static NetworkTable table;
+
+// same mapping WiFi.encryptionType() uses
+static uint8_t encryptionFromAuth(AUTH_MODE mode) {
+    switch (mode) {
+    case AUTH_OPEN:
+        return ENC_TYPE_NONE;
+    case AUTH_WEP:
+        return ENC_TYPE_WEP;
+    case AUTH_WPA_PSK:
+        return ENC_TYPE_TKIP;
+    case AUTH_WPA2_PSK:
+        return ENC_TYPE_CCMP;
+    default:
+        return ENC_TYPE_AUTO;
+    }
+}
+
+static bool seenThisSweep(uint8_t row) {
+    return (int32_t)(table.lastSeen[row] - sweepStart) >= 0;
+}
+
+static void pushSample(uint8_t row, int8_t rssi) {
+    table.history[row][table.historyHead[row]] = rssi;
+    table.historyHead[row] = (table.historyHead[row] + 1) % RSSI_HISTORY;
+    if (table.historyCount[row] < RSSI_HISTORY) {
+        table.historyCount[row]++;
+    }
+}
+
+static void copyRow(uint8_t dst, uint8_t src) {
+    memcpy(table.ssid[dst], table.ssid[src], SSID_SIZE);
+    memcpy(table.bssid[dst], table.bssid[src], 6);
+    table.rssi[dst] = table.rssi[src];
+    table.channel[dst] = table.channel[src];
+    table.encryption[dst] = table.encryption[src];
+    table.hidden[dst] = table.hidden[src];
+    table.lastSeen[dst] = table.lastSeen[src];
+    memcpy(table.history[dst], table.history[src], RSSI_HISTORY);
+    table.historyHead[dst] = table.historyHead[src];
+    table.historyCount[dst] = table.historyCount[src];
+}
+
+// moves the last row into the hole, order does not matter (NetworkView
+// sorts on its own)
+static void removeRow(uint8_t row) {
+    table.count--;
+    if (row != table.count) {
+        copyRow(row, table.count);
+    }
+}
+
+// a free row, or when full the longest-unseen AP that is not part of the
+// current sweep. -1 if every row was heard in this sweep
+static int allocRow() {
+    if (table.count < SCAN_MAX_NETWORKS) {
+        return table.count++;
+    }
+
+    int oldest = -1;
+    for (uint8_t row = 0; row < table.count; row++) {
+        if (seenThisSweep(row)) {
+            continue;
+        }
+        if (oldest < 0 ||
+            (int32_t)(table.lastSeen[row] - table.lastSeen[oldest]) < 0) {
+            oldest = row;
+        }
+    }
+    return oldest;
+}
+
+// Copies straight from the SDK's bss_info records, WiFi.SSID() would build
+// a heap String per network. Each AP gets one history sample per sweep, an
+// AP heard again on a neighbouring channel keeps the stronger reading.
+static void collectResults(int found) {
+    unsigned long now = millis();
+
+    for (int i = 0; i < found; i++) {
+        const bss_info *info = WiFi.getScanInfoByIndex(i);
+        if (!info) {
+            continue;
+        }
+
+        int row = scannerFind(info->bssid);
+        if (row >= 0 && seenThisSweep(row)) {
+            if (info->rssi > table.rssi[row]) {
+                table.rssi[row] = info->rssi;
+                table.channel[row] = info->channel;
+                uint8_t last =
+                    (table.historyHead[row] + RSSI_HISTORY - 1) % RSSI_HISTORY;
+                table.history[row][last] = info->rssi;
+            }
+            continue;
+        }
+
+        if (row < 0) {
+            row = allocRow();
+            if (row < 0) {
+                continue;
+            }
+            memcpy(table.bssid[row], info->bssid, 6);
+            table.historyHead[row] = 0;
+            table.historyCount[row] = 0;
+        }
+
+        // SSID and security may change between sweeps (AP reconfigured)
+        uint8_t len = info->ssid_len;
+        if (len > SSID_SIZE - 1) {
+            len = SSID_SIZE - 1;
+        }
+        memcpy(table.ssid[row], info->ssid, len);
+        table.ssid[row][len] = '\0';
+        table.rssi[row] = info->rssi;
+        table.channel[row] = info->channel;
+        table.encryption[row] = encryptionFromAuth(info->authmode);
+        table.hidden[row] = info->is_hidden || len == 0;
+        table.lastSeen[row] = now;
+        pushSample(row, info->rssi);
+    }
+}
+
+// end of a full sweep: APs that were not heard get a gap in their history,
+// the ones gone for longer than SCAN_AGE_OUT are dropped
+static void finishSweep() {
+    unsigned long now = millis();
+
+    uint8_t row = 0;
+    while (row < table.count) {
+        if (seenThisSweep(row)) {
+            row++;
+            continue;
+        }
+        if (now - table.lastSeen[row] >= SCAN_AGE_OUT) {
+            removeRow(row);
+            continue;
+        }
+        pushSample(row, RSSI_NONE);
+        row++;
+    }
+
+    state = SCAN_DONE;
+    sweepEnd = now;
+}
+
+/**
+ * @brief Puts the radio in station mode for scanning and sniffing
+ *
+ * Call at boot, before the first scannerTick(), and again whenever the radio
+ * was turned off (light sleep). The mode isn't persisted, so neither waits
+ * on an SDK flash write.
+ */
+void scannerBegin() {
+    WiFi.persistent(false);
+    WiFi.mode(WIFI_STA);
+    WiFi.disconnect();
+}
+
+/**
+ * @brief Starts a new sweep, one channel at a time
+ *
+ * Results are merged by BSSID into the table kept from earlier sweeps.
+ * Channels SCAN_FIRST_CHANNEL to SCAN_LAST_CHANNEL are scanned with separate
+ * async scans so progress can be reported per channel and results become
+ * available as each channel lands.
+ *
+ * @note Hidden networks are included
+ * @note Work happens in scannerTick(), this only arms the state machine.
+ *       Does nothing while a sweep is already running
+ */
+void scannerStart() {
+    if (state == SCAN_RUNNING || paused) {
+        return;
+    }
+    channel = SCAN_FIRST_CHANNEL;
+    sweepStart = millis();
+    sweep++;
+    state = SCAN_RUNNING;
+}
+
+/**
+ * @brief Stops scanning after the channel currently in flight
+ *
+ * Results collected so far are kept. The pending SDK scan is collected and
+ * discarded by scannerTick(), also when a new sweep has started by then.
+ */
+void scannerAbort() {
+    if (state == SCAN_RUNNING) {
+        state = SCAN_IDLE;
+    }
+}
+
+/**
+ * @brief Enables background monitoring
+ *
+ * While enabled a new sweep starts scannerSetInterval() ms after the
+ * previous one finished, independent of the screen being shown.
+ */
+void scannerSetMonitor(bool enabled) {
+    monitor = enabled;
+    if (monitor) {
+        scannerStart();
+    }
+}
+
+bool scannerMonitoring() { return monitor; }
+
+// pause between monitor sweeps, applies from the next sweep on
+void scannerSetInterval(unsigned long ms) { monitorInterval = ms; }
+
+/**
+ * @brief Keeps the radio free for something else (promiscuous mode)
+ *
+ * A running sweep is aborted and no new one starts, monitor mode included,
+ * until unpaused. Poll scannerBusy() before taking over the radio.
+ */
+void scannerPause(bool pause) {
+    paused = pause;
+    if (paused) {
+        scannerAbort();
+    }
+}
+
+// an SDK scan is still using the radio
+bool scannerBusy() { return inFlight; }
+
+/**
+ * @brief Polls the async scan, call once per loop() iteration
+ *
+ * @return true when a channel finished (new results or progress to show)
+ */
+bool scannerTick() {
+    bool changed = false;
+
+    if (monitor && !paused && state != SCAN_RUNNING && !inFlight &&
+        millis() - sweepEnd >= monitorInterval) {
+        scannerStart();
+    }
+
+    if (inFlight) {
+        int8_t found = WiFi.scanComplete();
+        if (found == WIFI_SCAN_RUNNING) {
+            return false;
+        }
+        inFlight = false;
+
+        // a scan left over from an aborted sweep says nothing about the
+        // channel this one is on
+        if (state == SCAN_RUNNING && inFlightSweep == sweep) {
+            if (found > 0) {
+                collectResults(found);
+            }
+            channel++;
+            if (channel > SCAN_LAST_CHANNEL) {
+                finishSweep();
+            }
+            changed = true;
+        }
+        WiFi.scanDelete();
+    }
+
+    if (state == SCAN_RUNNING) {
+        WiFi.scanNetworks(true, true, channel);
+        inFlight = true;
+        inFlightSweep = sweep;
+    }
+
+    return changed;
+}
+
+bool scannerRunning() { return state == SCAN_RUNNING; }
+
+bool scannerDone() { return state == SCAN_DONE; }
+
+uint8_t scannerChannelsDone() {
+    if (state == SCAN_DONE) {
+        return SCAN_CHANNELS;
+    }
+    return channel - SCAN_FIRST_CHANNEL;
+}
+
+int scannerCount() { return table.count; }
+
+const NetworkTable &scannerTable() { return table; }
+
+int scannerFind(const uint8_t *bssid) {
+    for (int i = 0; i < table.count; i++) {
+        if (memcmp(table.bssid[i], bssid, 6) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Reads an AP's RSSI history, oldest sample first
+ *
+ * @param i Sample index, 0 to historyCount - 1
+ * @return RSSI in dBm, or RSSI_NONE for a sweep the AP was missing from
+ */
+int8_t scannerHistory(uint8_t row, uint8_t i) {
+    uint8_t start = (table.historyHead[row] + RSSI_HISTORY -
+                     table.historyCount[row]) %
+                    RSSI_HISTORY;
+    return table.history[row][(start + i) % RSSI_HISTORY];
+}
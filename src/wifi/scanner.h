@@ -0,0 +1,56 @@
+#ifndef SCANNER_H
+#define SCANNER_H
+
+#include <stdint.h>
+
+constexpr uint8_t SCAN_FIRST_CHANNEL = 1;
+constexpr uint8_t SCAN_LAST_CHANNEL = 13;
+constexpr uint8_t SCAN_CHANNELS = SCAN_LAST_CHANNEL - SCAN_FIRST_CHANNEL + 1;
+constexpr uint8_t SCAN_MAX_NETWORKS = 32;
+
+constexpr uint8_t SSID_SIZE = 33; // 32 bytes + terminator
+
+// RSSI samples kept per AP, one per sweep. 32 APs * 16 samples = 512 bytes
+constexpr uint8_t RSSI_HISTORY = 16;
+constexpr int8_t RSSI_NONE = INT8_MIN; // AP missing from that sweep
+
+constexpr unsigned long SCAN_MONITOR_INTERVAL = 15000; // default between sweeps
+constexpr unsigned long SCAN_AGE_OUT = 90000; // drop APs unseen for this long
+
+// Scan results, one column per field so a pass over e.g. all RSSI values
+// (sorting, filtering) touches a few contiguous bytes instead of striding
+// over whole records. Rows are merged by BSSID across sweeps and only go
+// away through age-out, so row indices are not stable between sweeps -
+// hold on to a BSSID, not a row.
+struct NetworkTable {
+    char ssid[SCAN_MAX_NETWORKS][SSID_SIZE];
+    uint8_t bssid[SCAN_MAX_NETWORKS][6];
+    int8_t rssi[SCAN_MAX_NETWORKS];
+    uint8_t channel[SCAN_MAX_NETWORKS];
+    uint8_t encryption[SCAN_MAX_NETWORKS]; // ENC_TYPE_* values
+    bool hidden[SCAN_MAX_NETWORKS];
+    uint32_t lastSeen[SCAN_MAX_NETWORKS]; // millis()
+    int8_t history[SCAN_MAX_NETWORKS][RSSI_HISTORY]; // ring buffer
+    uint8_t historyHead[SCAN_MAX_NETWORKS];          // next slot to write
+    uint8_t historyCount[SCAN_MAX_NETWORKS];
+    uint8_t count;
+};
+
+void scannerBegin();
+void scannerStart();
+void scannerAbort();
+void scannerSetMonitor(bool enabled);
+bool scannerMonitoring();
+void scannerSetInterval(unsigned long ms);
+void scannerPause(bool pause);
+bool scannerBusy();
+bool scannerTick();
+bool scannerRunning();
+bool scannerDone();
+uint8_t scannerChannelsDone();
+int scannerCount();
+const NetworkTable &scannerTable();
+int scannerFind(const uint8_t *bssid);
+int8_t scannerHistory(uint8_t row, uint8_t i);
+
+#endif
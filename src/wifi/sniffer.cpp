@@ -0,0 +1,164 @@
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+
+#include "sniffer.h"
+
+// a beacon every 102.4 ms, so an AP that stayed quiet during our dwell
+// still costs its channel about this many frames/s
+constexpr uint16_t AP_FRAME_WEIGHT = 10;
+
+// 2.4 GHz channels are 5 MHz apart but 20 MHz wide, traffic on a channel
+// also hurts the three on either side
+constexpr int OVERLAP = 3;
+
+enum SnifferState : uint8_t { SNIFF_IDLE, SNIFF_WAITING, SNIFF_RUNNING };
+
+static SnifferState state = SNIFF_IDLE;
+static unsigned long dwellStart = 0;
+static ChannelStats stats;
+
+// written by the radio callback, one slot per channel so a frame that
+// arrives around a hop is never booked on the wrong one
+static volatile uint16_t frames[SCAN_CHANNELS];
+static volatile uint8_t hopIndex = 0;
+
+static uint16_t saturate16(uint32_t value) {
+    return value > UINT16_MAX ? UINT16_MAX : value;
+}
+
+// only counts frames, their content doesn't matter
+static void onFrame(uint8_t *buf, uint16_t len) {
+    (void)buf;
+    (void)len;
+
+    uint16_t count = frames[hopIndex];
+    if (count < UINT16_MAX) {
+        frames[hopIndex] = count + 1;
+    }
+}
+
+static void hopTo(uint8_t index) {
+    hopIndex = index;
+    wifi_set_channel(SCAN_FIRST_CHANNEL + index);
+    dwellStart = millis();
+}
+
+static void countAccessPoints() {
+    const NetworkTable &table = scannerTable();
+
+    memset(stats.apCount, 0, sizeof(stats.apCount));
+    for (uint8_t row = 0; row < table.count; row++) {
+        int index = table.channel[row] - SCAN_FIRST_CHANNEL;
+        if (index >= 0 && index < SCAN_CHANNELS &&
+            stats.apCount[index] < UINT8_MAX) {
+            stats.apCount[index]++;
+        }
+    }
+}
+
+// own and neighbouring load, weighted down with channel distance
+static void updateCongestion() {
+    for (int i = 0; i < SCAN_CHANNELS; i++) {
+        uint32_t sum = 0;
+        for (int d = -OVERLAP; d <= OVERLAP; d++) {
+            int j = i + d;
+            if (j < 0 || j >= SCAN_CHANNELS) {
+                continue;
+            }
+            uint32_t load =
+                stats.frameRate[j] + AP_FRAME_WEIGHT * stats.apCount[j];
+            sum += load * (OVERLAP + 1 - abs(d));
+        }
+        stats.busy[i] = saturate16(sum / (OVERLAP + 1));
+    }
+
+    // only the non-overlapping channels are worth recommending
+    static const uint8_t candidates[] = {1, 6, 11};
+    stats.quietest = candidates[0];
+    for (uint8_t channel : candidates) {
+        if (stats.busy[channel - SCAN_FIRST_CHANNEL] <
+            stats.busy[stats.quietest - SCAN_FIRST_CHANNEL]) {
+            stats.quietest = channel;
+        }
+    }
+}
+
+/**
+ * @brief Starts the channel analyzer
+ *
+ * Background scanning is paused, promiscuous mode can't share the radio
+ * with a scan. The radio is switched over by snifferTick() once the scan
+ * still in flight (if any) has been collected.
+ */
+void snifferStart() {
+    memset(&stats, 0, sizeof(stats));
+    stats.quietest = 1;
+    scannerPause(true);
+    state = SNIFF_WAITING;
+}
+
+/**
+ * @brief Leaves promiscuous mode and lets the scanner run again
+ */
+void snifferStop() {
+    if (state == SNIFF_RUNNING) {
+        wifi_promiscuous_enable(0);
+        wifi_set_promiscuous_rx_cb(nullptr);
+    }
+    if (state != SNIFF_IDLE) {
+        scannerPause(false);
+    }
+    state = SNIFF_IDLE;
+}
+
+/**
+ * @brief Hops channels and folds the frame counters into the stats
+ *
+ * Call once per loop() iteration. The callback only bumps a counter, all
+ * arithmetic happens here after each SNIFF_DWELL.
+ *
+ * @return true when the stats changed
+ */
+bool snifferTick() {
+    if (state == SNIFF_WAITING) {
+        if (scannerBusy()) {
+            return false;
+        }
+        memset((void *)frames, 0, sizeof(frames));
+        wifi_promiscuous_enable(0);
+        wifi_set_promiscuous_rx_cb(onFrame);
+        wifi_promiscuous_enable(1);
+        hopTo(0);
+        state = SNIFF_RUNNING;
+        return false;
+    }
+
+    if (state != SNIFF_RUNNING) {
+        return false;
+    }
+
+    unsigned long elapsed = millis() - dwellStart;
+    if (elapsed < SNIFF_DWELL) {
+        return false;
+    }
+
+    uint8_t index = hopIndex;
+    noInterrupts();
+    uint16_t count = frames[index];
+    frames[index] = 0;
+    interrupts();
+
+    uint32_t rate = (uint32_t)count * 1000 / elapsed;
+    uint16_t &smoothed = stats.frameRate[index];
+    smoothed = saturate16((smoothed * 3u + rate) / 4);
+
+    hopTo((index + 1) % SCAN_CHANNELS);
+
+    countAccessPoints();
+    updateCongestion();
+    return true;
+}
+
+bool snifferRunning() { return state != SNIFF_IDLE; }
+
+const ChannelStats &snifferStats() { return stats; }
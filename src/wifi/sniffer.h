@@ -0,0 +1,25 @@
+#ifndef SNIFFER_H
+#define SNIFFER_H
+
+#include <stdint.h>
+
+#include "scanner.h"
+
+constexpr unsigned long SNIFF_DWELL = 200; // ms spent on each channel
+
+// Per-channel picture built by the analyzer, indexed from
+// SCAN_FIRST_CHANNEL. Updated once per dwell, read by the renderer.
+struct ChannelStats {
+    uint16_t frameRate[SCAN_CHANNELS]; // frames/s heard, smoothed
+    uint8_t apCount[SCAN_CHANNELS];    // APs in the scan table
+    uint16_t busy[SCAN_CHANNELS];      // overlap-weighted congestion
+    uint8_t quietest;                  // best of channels 1/6/11
+};
+
+void snifferStart();
+void snifferStop();
+bool snifferTick();
+bool snifferRunning();
+const ChannelStats &snifferStats();
+
+#endif